@@ -0,0 +1,172 @@
+#include "aiworker.h"
+#include "profile.h"
+
+// Troca a tarefa pendente e interrompe a busca em andamento. Deve ser chamada com o lock.
+static void setJob(AiWorker* worker, AiJob job, const BoardState* pos) {
+    worker->job = job;
+    if (pos) {
+        worker->jobPosition = *pos;
+    }
+    worker->generation++;
+    atomic_store(&worker->cancel, true);
+    SDL_CondSignal(worker->wake);
+}
+
+// Função para buscar a jogada com o motor escolhido: MCTS, se o worker tiver uma árvore, ou alfa-beta.
+static SearchResult search(AiWorker* worker, const BoardState* pos) {
+    if (worker->mcts) {
+        return worker->variant->mctsBestMove(worker->mcts, pos, &worker->limits);
+    }
+    return worker->variant->searchBestMove(worker->engine, pos, &worker->limits);
+}
+
+// Função para calcular a jogada do computador, usando a resposta ponderada se houver uma.
+static void think(AiWorker* worker, const BoardState* pos, Uint32 generation) {
+    uint64_t start = profileBegin();
+    int col = -1;
+    for (int i = 0; i < worker->variant->cols; ++i) {
+        if (worker->ponder[i].valid && worker->variant->samePosition(&worker->ponder[i].position, pos)) {
+            col = worker->ponder[i].col;
+            break;
+        }
+    }
+    if (col < 0) {
+        SearchResult result = search(worker, pos);
+        if (result.cancelled) {
+            return;
+        }
+        profileSearch(&result);
+        col = result.bestCol;
+    }
+    profileEnd("aiMove", start);
+
+    SDL_LockMutex(worker->lock);
+    bool current = worker->generation == generation;
+    SDL_UnlockMutex(worker->lock);
+    if (current) {
+        SDL_Event event = {0};
+        event.type = worker->eventType;
+        event.user.code = col;
+        event.user.data1 = (void*)(uintptr_t)generation;
+        SDL_PushEvent(&event);
+    }
+}
+
+// Função para buscar a resposta a cada jogada do humano, começando pela que a heurística considera
+// mais provável e seguindo do centro para as bordas. Cada busca também enche a tabela de transposição.
+static void ponder(AiWorker* worker, const BoardState* pos) {
+    const BoardVariant* variant = worker->variant;
+    for (int i = 0; i < variant->cols; ++i) {
+        worker->ponder[i].valid = false;
+    }
+
+    int guess = variant->heuristicMove(pos);
+    for (int i = -1; i < variant->cols; ++i) {
+        int col = i < 0 ? guess : variant->cols / 2 + (i % 2 == 0 ? i / 2 : -(i + 1) / 2);
+        if ((i >= 0 && col == guess) || !variant->canPlay(pos, col) || variant->winsWith(pos, col)) {
+            continue;  // Jogadas que terminam o jogo não precisam de resposta
+        }
+        BoardState child = *pos;
+        variant->play(&child, col);
+        if (variant->isFull(&child)) {
+            continue;
+        }
+        uint64_t start = profileBegin();
+        SearchResult result = search(worker, &child);
+        profileEnd("ponder", start);
+        if (result.cancelled) {
+            return;
+        }
+        worker->ponder[col] = (PonderEntry){.position = child, .col = result.bestCol, .valid = true};
+    }
+}
+
+// Laço da thread do worker: espera uma tarefa, executa sem o lock e volta a esperar.
+static int workerMain(void* arg) {
+    AiWorker* worker = arg;
+    SDL_LockMutex(worker->lock);
+    while (!worker->quit) {
+        if (worker->job == AI_JOB_NONE) {
+            SDL_CondWait(worker->wake, worker->lock);
+            continue;
+        }
+        AiJob job = worker->job;
+        BoardState pos = worker->jobPosition;
+        Uint32 generation = worker->generation;
+        worker->job = AI_JOB_NONE;
+        atomic_store(&worker->cancel, false);
+        SDL_UnlockMutex(worker->lock);
+
+        if (job == AI_JOB_MOVE) {
+            think(worker, &pos, generation);
+        } else {
+            ponder(worker, &pos);
+        }
+
+        SDL_LockMutex(worker->lock);
+    }
+    SDL_UnlockMutex(worker->lock);
+    return 0;
+}
+
+bool aiWorkerStart(AiWorker* worker, Engine* engine, Mcts* mcts, const BoardVariant* variant,
+                   const SearchLimits* limits) {
+    *worker = (AiWorker){.engine = engine, .mcts = mcts, .variant = variant, .limits = *limits};
+    atomic_init(&worker->cancel, false);
+    worker->limits.cancel = &worker->cancel;
+    worker->eventType = SDL_RegisterEvents(1);
+    if (worker->eventType == (Uint32)-1) {
+        return false;
+    }
+    worker->lock = SDL_CreateMutex();
+    worker->wake = SDL_CreateCond();
+    if (!worker->lock || !worker->wake) {
+        aiWorkerStop(worker);
+        return false;
+    }
+    worker->thread = SDL_CreateThread(workerMain, "IA", worker);
+    if (!worker->thread) {
+        aiWorkerStop(worker);
+        return false;
+    }
+    return true;
+}
+
+void aiWorkerStop(AiWorker* worker) {
+    if (worker->thread) {
+        SDL_LockMutex(worker->lock);
+        worker->quit = true;
+        setJob(worker, AI_JOB_NONE, nullptr);
+        SDL_UnlockMutex(worker->lock);
+        SDL_WaitThread(worker->thread, nullptr);
+        worker->thread = nullptr;
+    }
+    if (worker->wake) {
+        SDL_DestroyCond(worker->wake);
+        worker->wake = nullptr;
+    }
+    if (worker->lock) {
+        SDL_DestroyMutex(worker->lock);
+        worker->lock = nullptr;
+    }
+}
+
+Uint32 aiRequestMove(AiWorker* worker, const BoardState* pos) {
+    SDL_LockMutex(worker->lock);
+    setJob(worker, AI_JOB_MOVE, pos);
+    Uint32 generation = worker->generation;
+    SDL_UnlockMutex(worker->lock);
+    return generation;
+}
+
+void aiPonder(AiWorker* worker, const BoardState* pos) {
+    SDL_LockMutex(worker->lock);
+    setJob(worker, AI_JOB_PONDER, pos);
+    SDL_UnlockMutex(worker->lock);
+}
+
+void aiCancel(AiWorker* worker) {
+    SDL_LockMutex(worker->lock);
+    setJob(worker, AI_JOB_NONE, nullptr);
+    SDL_UnlockMutex(worker->lock);
+}
@@ -0,0 +1,61 @@
+#ifndef AIWORKER_H
+#define AIWORKER_H
+
+#include <SDL2/SDL.h>
+#include "search.h"
+#include "variant.h"
+
+// Jogador do computador em uma thread separada, para a interface continuar desenhando e respondendo
+// enquanto a busca roda. A jogada calculada volta ao laço de eventos como um evento SDL do tipo
+// eventType, com a coluna em user.code e a geração do pedido em user.data1.
+// Durante a vez do humano o worker "pondera": busca a resposta para cada jogada provável do humano e
+// guarda o resultado, de modo que o pedido seguinte muitas vezes é respondido na hora.
+
+typedef enum {
+    AI_JOB_NONE,
+    AI_JOB_MOVE,    // Calcular a jogada do computador
+    AI_JOB_PONDER   // Preparar respostas enquanto o humano pensa
+} AiJob;
+
+// Resposta preparada para a posição após uma jogada do humano.
+typedef struct {
+    BoardState position; // Posição após a jogada do humano (a chave de 64 bits não a identifica em todo tamanho)
+    int col;        // Coluna que o computador vai jogar nela
+    bool valid;
+} PonderEntry;
+
+typedef struct {
+    SDL_Thread* thread;
+    SDL_mutex* lock;
+    SDL_cond* wake;
+    Engine* engine;         // Usado só pela thread do worker enquanto ela existir
+    Mcts* mcts;             // Se não for nullptr, as jogadas vêm do MCTS em vez da busca alfa-beta
+    const BoardVariant* variant;
+    SearchLimits limits;    // Limites de cada busca (cancel é preenchido pelo worker)
+    Uint32 eventType;       // Tipo do evento SDL com a jogada calculada
+    // Campos protegidos por lock
+    AiJob job;              // Próxima tarefa, ainda não iniciada
+    BoardState jobPosition;
+    Uint32 generation;      // Muda a cada pedido ou cancelamento; resultados de gerações antigas são descartados
+    bool quit;
+    // Interrompe a busca em andamento (ligado por quem pede uma nova tarefa)
+    atomic_bool cancel;
+    // Acessado só pela thread do worker
+    PonderEntry ponder[VARIANT_MAX_COLS];
+} AiWorker;
+
+// Função para iniciar a thread do worker. O motor e a árvore do MCTS (opcional) não devem ser usados por
+// outra thread até aiWorkerStop.
+bool aiWorkerStart(AiWorker* worker, Engine* engine, Mcts* mcts, const BoardVariant* variant,
+                   const SearchLimits* limits);
+// Função para interromper a busca em andamento e encerrar a thread.
+void aiWorkerStop(AiWorker* worker);
+
+// Função para pedir a jogada do computador na posição dada. Devolve a geração que virá no evento.
+Uint32 aiRequestMove(AiWorker* worker, const BoardState* pos);
+// Função para ponderar as respostas às jogadas do humano, que é o jogador da vez na posição dada.
+void aiPonder(AiWorker* worker, const BoardState* pos);
+// Função para descartar a tarefa em andamento (por exemplo, ao reiniciar o jogo).
+void aiCancel(AiWorker* worker);
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef BOARDSIZE_H
+#define BOARDSIZE_H
+
+// Tamanho do tabuleiro, fixado na compilação. A lógica e a IA são compiladas uma vez para cada variante
+// suportada (ver CMakeLists.txt), definindo BOARD_VARIANT (colunas x linhas), ROWS e COLS; sem essas
+// definições vale o tabuleiro padrão de 7 colunas por 6 linhas.
+#ifndef BOARD_VARIANT
+#define BOARD_VARIANT 7x6
+#define ROWS 6
+#define COLS 7
+#endif
+
+// Os símbolos externos cujo código depende do tamanho levam o nome da variante como sufixo
+// (searchBestMove_9x7, ...), para que várias variantes convivam no mesmo executável.
+#define BOARD_SYMBOL_(name, variant) name##_##variant
+#define BOARD_SYMBOL_EXPAND(name, variant) BOARD_SYMBOL_(name, variant)
+#define BOARD_SYMBOL(name) BOARD_SYMBOL_EXPAND(name, BOARD_VARIANT)
+
+#define positionFromMoves BOARD_SYMBOL(positionFromMoves)
+#define engineInit BOARD_SYMBOL(engineInit)
+#define engineFree BOARD_SYMBOL(engineFree)
+#define searchBestMove BOARD_SYMBOL(searchBestMove)
+#define searchHeuristicMove BOARD_SYMBOL(searchHeuristicMove)
+#define bookOpen BOARD_SYMBOL(bookOpen)
+#define bookClose BOARD_SYMBOL(bookClose)
+#define bookProbe BOARD_SYMBOL(bookProbe)
+#define bookWrite BOARD_SYMBOL(bookWrite)
+#define bookCanonicalKey BOARD_SYMBOL(bookCanonicalKey)
+#define endgameOpen BOARD_SYMBOL(endgameOpen)
+#define endgameClose BOARD_SYMBOL(endgameClose)
+#define endgameProbe BOARD_SYMBOL(endgameProbe)
+#define endgameWrite BOARD_SYMBOL(endgameWrite)
+#define endgamePackScore BOARD_SYMBOL(endgamePackScore)
+#define mctsInit BOARD_SYMBOL(mctsInit)
+#define mctsFree BOARD_SYMBOL(mctsFree)
+#define mctsBestMove BOARD_SYMBOL(mctsBestMove)
+#define boardVariant BOARD_SYMBOL(boardVariant)
+
+#endif
@@ -0,0 +1,112 @@
+#include "book.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mapfile.h"
+
+bool bookOpen(OpeningBook* book, const char* path) {
+    *book = (OpeningBook){0};
+    if (!POSITION_KEY_UNIQUE) {
+        return false;  // A chave de 64 bits não identifica as posições deste tabuleiro
+    }
+    size_t size;
+    void* data = mapFile(path, &size);
+    if (!data) {
+        return false;
+    }
+
+    // A contagem é comparada por divisão: multiplicá-la poderia estourar e aceitar um arquivo truncado
+    const BookHeader* header = data;
+    if (size < sizeof(BookHeader) || memcmp(header->magic, BOOK_MAGIC, 4) != 0 || header->version != BOOK_VERSION ||
+        header->rows != ROWS || header->cols != COLS ||
+        header->count > (size - sizeof(BookHeader)) / (sizeof(uint64_t) + sizeof(uint32_t))) {
+        unmapFile(data, size);
+        return false;
+    }
+
+    book->keys = (const uint64_t*)(header + 1);
+    book->values = (const uint32_t*)(book->keys + header->count);
+    book->count = header->count;
+    book->maxMoves = (int)header->maxMoves;
+    book->data = data;
+    book->size = size;
+    return true;
+}
+
+void bookClose(OpeningBook* book) {
+    if (book->data) {
+        unmapFile(book->data, book->size);
+    }
+    *book = (OpeningBook){0};
+}
+
+static int compareRecords(const void* a, const void* b) {
+    uint64_t ka = ((const BookRecord*)a)->key;
+    uint64_t kb = ((const BookRecord*)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+bool bookWrite(const char* path, BookRecord* records, size_t count, int maxMoves) {
+    qsort(records, count, sizeof(BookRecord), compareRecords);
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    BookHeader header = {.version = BOOK_VERSION, .rows = ROWS, .cols = COLS, .maxMoves = (uint32_t)maxMoves,
+                         .count = count};
+    memcpy(header.magic, BOOK_MAGIC, 4);
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (size_t i = 0; ok && i < count; ++i) {
+        ok = fwrite(&records[i].key, sizeof(uint64_t), 1, file) == 1;
+    }
+    for (size_t i = 0; ok && i < count; ++i) {
+        ok = fwrite(&records[i].value, sizeof(uint32_t), 1, file) == 1;
+    }
+    return fclose(file) == 0 && ok;
+}
+
+// Espelha um bitboard trocando a coluna c pela coluna COLS - 1 - c.
+static Bitboard mirrorBitboard(Bitboard board) {
+    const Bitboard column = ((Bitboard)1 << COL_BITS) - 1;
+    Bitboard mirrored = 0;
+    for (int col = 0; col < COLS; ++col) {
+        mirrored |= ((board >> (col * COL_BITS)) & column) << ((COLS - 1 - col) * COL_BITS);
+    }
+    return mirrored;
+}
+
+uint64_t bookCanonicalKey(const Position* pos, bool* mirrored) {
+    uint64_t key = positionKey(pos);
+    uint64_t mirrorKey = bitboardKey(mirrorBitboard(pos->current), mirrorBitboard(pos->mask));
+    *mirrored = mirrorKey < key;
+    return *mirrored ? mirrorKey : key;
+}
+
+bool bookProbe(const OpeningBook* book, const Position* pos, BookMove* move) {
+    if (book->count == 0 || pos->moves > book->maxMoves) {
+        return false;
+    }
+    bool mirrored;
+    uint64_t key = bookCanonicalKey(pos, &mirrored);
+
+    size_t low = 0;
+    size_t high = book->count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (book->keys[mid] < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == book->count || book->keys[low] != key) {
+        return false;
+    }
+
+    *move = bookUnpackValue(book->values[low]);
+    if (mirrored) {
+        move->col = COLS - 1 - move->col;
+    }
+    return true;
+}
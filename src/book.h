@@ -0,0 +1,78 @@
+#ifndef BOOK_H
+#define BOOK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "position.h"
+
+// Livro de aberturas em arquivo binário, mapeado na memória sem etapa de leitura ou conversão.
+// Formato (inteiros na ordem de bytes da máquina que gerou o arquivo):
+//   BookHeader
+//   uint64_t keys[count]    chaves canônicas em ordem crescente
+//   uint32_t values[count]  resultado de cada chave (ver bookPackValue)
+// Posições espelhadas (coluna c <-> COLS - 1 - c) compartilham a mesma entrada: a chave canônica é a
+// menor entre a da posição e a da sua imagem, e a coluna gravada é a da posição canônica.
+
+#define BOOK_MAGIC "C4BK"
+#define BOOK_VERSION 1
+
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint8_t rows;
+    uint8_t cols;
+    uint32_t maxMoves;     // Maior número de jogadas das posições gravadas
+    uint32_t reserved;
+    uint64_t count;
+} BookHeader;
+
+typedef struct {
+    int col;
+    int score;
+    int depth;
+    bool solved;
+} BookMove;
+
+typedef struct {
+    const uint64_t* keys;
+    const uint32_t* values;
+    size_t count;
+    int maxMoves;
+    void* data;            // Região mapeada (ou lida) do arquivo
+    size_t size;
+} OpeningBook;
+
+// Função para abrir um livro; devolve false se o arquivo não existe ou não é compatível.
+bool bookOpen(OpeningBook* book, const char* path);
+void bookClose(OpeningBook* book);
+
+// Função para consultar uma posição no livro (busca binária pela chave canônica).
+bool bookProbe(const OpeningBook* book, const Position* pos, BookMove* move);
+
+// Um registro do livro ainda não gravado (usado pelo gerador).
+typedef struct {
+    uint64_t key;
+    uint32_t value;
+} BookRecord;
+
+// Função para ordenar e gravar registros em um arquivo de livro.
+bool bookWrite(const char* path, BookRecord* records, size_t count, int maxMoves);
+
+// Chave canônica de uma posição; espelhada indica que a canônica é a imagem da posição.
+uint64_t bookCanonicalKey(const Position* pos, bool* mirrored);
+
+static inline uint32_t bookPackValue(const BookMove* move) {
+    return (uint32_t)(uint16_t)(int16_t)move->score | (uint32_t)(move->col & 0xF) << 16 |
+           (uint32_t)(move->depth & 0x7F) << 20 | (uint32_t)move->solved << 27;
+}
+
+static inline BookMove bookUnpackValue(uint32_t value) {
+    return (BookMove){
+        .score = (int16_t)(uint16_t)value,
+        .col = (int)(value >> 16 & 0xF),
+        .depth = (int)(value >> 20 & 0x7F),
+        .solved = (value >> 27 & 1) != 0,
+    };
+}
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+#include <time.h>
+
+// Relógio em microssegundos independente da SDL, usado pelos limites de tempo da busca.
+static inline uint64_t clockNowUs(void) {
+    struct timespec ts;
+#ifdef TIME_MONOTONIC
+    timespec_get(&ts, TIME_MONOTONIC);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+#endif
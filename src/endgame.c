@@ -0,0 +1,108 @@
+#include "endgame.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "book.h"
+#include "mapfile.h"
+#include "search.h"
+
+int8_t endgamePackScore(int score) {
+    return (int8_t)(score > 0 ? SCORE_WIN - score : score < 0 ? -(SCORE_WIN + score) : 0);
+}
+
+static int unpackScore(int8_t value) {
+    return value > 0 ? SCORE_WIN - value : value < 0 ? -(SCORE_WIN + value) : 0;
+}
+
+bool endgameOpen(EndgameTable* table, const char* path) {
+    *table = (EndgameTable){0};
+    if (!POSITION_KEY_UNIQUE) {
+        return false;  // A chave de 64 bits não identifica as posições deste tabuleiro
+    }
+    size_t size;
+    void* data = mapFile(path, &size);
+    if (!data) {
+        return false;
+    }
+
+    const EndgameHeader* header = data;
+    if (size < sizeof(EndgameHeader) || memcmp(header->magic, ENDGAME_MAGIC, 4) != 0 ||
+        header->version != ENDGAME_VERSION || header->rows != ROWS || header->cols != COLS ||
+        header->capacity == 0 || (header->capacity & (header->capacity - 1)) != 0 ||
+        size < sizeof(EndgameHeader) + header->capacity * (sizeof(uint64_t) + sizeof(int8_t))) {
+        unmapFile(data, size);
+        return false;
+    }
+
+    table->keys = (const uint64_t*)(header + 1);
+    table->values = (const int8_t*)(table->keys + header->capacity);
+    table->capacity = header->capacity;
+    table->count = header->count;
+    table->maxEmpty = (int)header->maxEmpty;
+    table->minMoves = ROWS * COLS - table->maxEmpty;
+    table->data = data;
+    table->size = size;
+    return true;
+}
+
+void endgameClose(EndgameTable* table) {
+    if (table->data) {
+        unmapFile(table->data, table->size);
+    }
+    *table = (EndgameTable){0};
+}
+
+bool endgameProbe(const EndgameTable* table, const Position* pos, int* score) {
+    if (table->count == 0 || pos->moves < table->minMoves) {
+        return false;
+    }
+    bool mirrored;
+    uint64_t key = bookCanonicalKey(pos, &mirrored);
+    for (size_t i = endgameSlot(key, table->capacity);; i = (i + 1) & (table->capacity - 1)) {
+        if (table->keys[i] == key) {
+            *score = unpackScore(table->values[i]);
+            return true;
+        }
+        if (table->keys[i] == 0) {
+            return false;
+        }
+    }
+}
+
+bool endgameWrite(const char* path, const uint64_t* keys, const int8_t* values, size_t count, int maxEmpty) {
+    // No máximo metade das entradas ocupadas: uma consulta sem sucesso para em poucas sondagens
+    size_t capacity = 1024;
+    while (capacity < 2 * count) {
+        capacity *= 2;
+    }
+    uint64_t* tableKeys = calloc(capacity, sizeof(uint64_t));
+    int8_t* tableValues = calloc(capacity, sizeof(int8_t));
+    if (!tableKeys || !tableValues) {
+        free(tableKeys);
+        free(tableValues);
+        return false;
+    }
+    for (size_t n = 0; n < count; ++n) {
+        size_t i = endgameSlot(keys[n], capacity);
+        while (tableKeys[i] != 0) {
+            i = (i + 1) & (capacity - 1);
+        }
+        tableKeys[i] = keys[n];
+        tableValues[i] = values[n];
+    }
+
+    FILE* file = fopen(path, "wb");
+    bool ok = file != nullptr;
+    if (ok) {
+        EndgameHeader header = {.version = ENDGAME_VERSION, .rows = ROWS, .cols = COLS,
+                                .maxEmpty = (uint32_t)maxEmpty, .count = count, .capacity = capacity};
+        memcpy(header.magic, ENDGAME_MAGIC, 4);
+        ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(tableKeys, sizeof(uint64_t), capacity, file) == capacity &&
+             fwrite(tableValues, sizeof(int8_t), capacity, file) == capacity;
+        ok = fclose(file) == 0 && ok;
+    }
+    free(tableKeys);
+    free(tableValues);
+    return ok;
+}
@@ -0,0 +1,62 @@
+#ifndef ENDGAME_H
+#define ENDGAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "position.h"
+
+// Banco de finais: valor exato de posições com poucas casas vazias, gerado por c4endgamegen e mapeado na
+// memória como o livro de aberturas. A busca consulta o banco em cada nó dentro do seu alcance e não
+// desce abaixo de uma posição encontrada.
+// Formato (inteiros na ordem de bytes da máquina que gerou o arquivo):
+//   EndgameHeader
+//   uint64_t keys[capacity]   tabela de espalhamento com sondagem linear: chave canônica (0 = vazio)
+//   int8_t values[capacity]   resultado de cada chave (ver endgamePackScore)
+// Como no livro, uma posição e sua imagem espelhada compartilham a entrada da chave canônica.
+// Posições em que o jogador da vez vence na hora não são gravadas: a busca as reconhece antes de consultar.
+
+#define ENDGAME_MAGIC "C4EG"
+#define ENDGAME_VERSION 1
+
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint8_t rows;
+    uint8_t cols;
+    uint32_t maxEmpty;     // Maior número de casas vazias das posições gravadas
+    uint32_t reserved;
+    uint64_t count;        // Posições gravadas
+    uint64_t capacity;     // Entradas da tabela (potência de 2)
+} EndgameHeader;
+
+typedef struct {
+    const uint64_t* keys;
+    const int8_t* values;
+    size_t capacity;
+    size_t count;
+    int maxEmpty;
+    int minMoves;          // Posições com menos jogadas estão fora do alcance do banco
+    void* data;            // Região mapeada (ou lida) do arquivo
+    size_t size;
+} EndgameTable;
+
+// Função para abrir um banco de finais; devolve false se o arquivo não existe ou não é compatível.
+bool endgameOpen(EndgameTable* table, const char* path);
+void endgameClose(EndgameTable* table);
+
+// Função para consultar o valor exato de uma posição, do ponto de vista do jogador da vez.
+bool endgameProbe(const EndgameTable* table, const Position* pos, int* score);
+
+// Função para gravar um banco a partir de chaves canônicas e valores já empacotados (usada pelo gerador).
+bool endgameWrite(const char* path, const uint64_t* keys, const int8_t* values, size_t count, int maxEmpty);
+
+// Função para empacotar uma pontuação exata em um byte: 0 é empate e, nas vitórias e derrotas, o módulo
+// é o número de peças no tabuleiro ao fim do jogo (o sinal é o do resultado para o jogador da vez).
+int8_t endgamePackScore(int score);
+
+// Entrada inicial da sondagem de uma chave.
+static inline size_t endgameSlot(uint64_t key, size_t capacity) {
+    return (size_t)((key * 0x9E3779B97F4A7C15u) >> 32) & (capacity - 1);
+}
+
+#endif
@@ -0,0 +1,115 @@
+#include "game.h"
+
+// Função para inicializar o estado do jogo, incluindo a configuração do tabuleiro e do jogador inicial.
+void initGame(Game* game, const BoardVariant* variant, bool vsComputer) {
+    game->variant = variant;
+    variant->init(&game->position);
+    game->currentPlayer = PLAYER1;
+    game->gameOver = false;
+    game->winner = NONE;
+    game->vsComputer = vsComputer;
+    game->selectedCol = -1;
+    game->isDropping = false;
+    game->dropRow = 0;
+    game->dropY = 0;
+    game->dropStartTicks = 0;
+    game->historyLength = 0;
+    game->startTime = time(nullptr);
+}
+
+// Função para simular a queda de uma peça em uma coluna específica e atualizar o tabuleiro.
+bool dropPiece(Game* game, int col) {
+    if (!game->variant->canPlay(&game->position, col)) {
+        return false;
+    }
+    game->variant->play(&game->position, col);
+    game->history[game->historyLength++] = (uint8_t)col;
+    return true;
+}
+
+// Função para verificar se a última jogada venceu o jogo, retornando o jogador vencedor ou NONE se não houver vitória.
+// A sequência vencedora só é calculada quando a vitória acontece, para o destaque da tela final.
+Player checkVictory(Game* game) {
+    const BoardVariant* variant = game->variant;
+    if (variant->moves(&game->position) == 0 || !variant->lastMoveWon(&game->position)) {
+        return NONE;
+    }
+    Player winner = otherPlayer(variant->playerToMove(&game->position));
+    int cols[4], rows[4];
+    variant->findFour(&game->position, winner, cols, rows);
+    for (int i = 0; i < 4; ++i) {
+        game->winningSequence[i] = (SDL_Point){cols[i], rows[i]};
+    }
+    return winner;
+}
+
+// Função para verificar se o tabuleiro está completamente preenchido, indicando um empate.
+bool boardFull(const Game* game) {
+    return game->variant->isFull(&game->position);
+}
+
+// Função para alternar entre os jogadores após uma jogada.
+void switchPlayer(Game* game) {
+    game->currentPlayer = (game->currentPlayer == PLAYER1) ? PLAYER2 : PLAYER1;
+}
+
+// Função para realizar a jogada em uma coluna e verificar o estado do jogo após o movimento.
+void playMove(Game* game, int col) {
+    if (dropPiece(game, col)) {
+        Player winner = checkVictory(game);
+        if (winner != NONE) {
+            game->winner = winner;
+            game->gameOver = true;
+        } else if (boardFull(game)) {
+            game->gameOver = true;
+        } else {
+            switchPlayer(game);
+        }
+    }
+}
+
+// Função para trocar de cena, marcando o instante da entrada.
+void enterScene(Scene* scene, SceneId id) {
+    scene->id = id;
+    scene->enteredTicks = SDL_GetTicks();
+    scene->stage = GAME_OVER_BOARD;
+}
+
+// Função para obter a etapa da tela final pelo tempo decorrido desde o fim da partida.
+GameOverStage gameOverStage(Uint32 elapsed) {
+    if (elapsed < GAME_OVER_PAUSE_MS) {
+        return GAME_OVER_BOARD;
+    }
+    if (elapsed < GAME_OVER_PAUSE_MS + GAME_OVER_HIGHLIGHT_MS) {
+        return GAME_OVER_HIGHLIGHT;
+    }
+    if (elapsed < GAME_OVER_PAUSE_MS + GAME_OVER_HIGHLIGHT_MS + GAME_OVER_MESSAGE_MS) {
+        return GAME_OVER_MESSAGE;
+    }
+    return GAME_OVER_DONE;
+}
+
+// Função para calcular quanto o laço principal pode dormir à espera de eventos, em milissegundos (-1 para
+// esperar sem limite): até a próxima etapa da tela final ou até o próximo quadro da queda de uma peça.
+int sceneTimeout(const Scene* scene, const Game* game) {
+    if (scene->id == SCENE_PLAYING && game->isDropping) {
+        return FRAME_INTERVAL_MS;
+    }
+    if (scene->id == SCENE_GAME_OVER) {
+        Uint32 elapsed = SDL_GetTicks() - scene->enteredTicks;
+        Uint32 next = GAME_OVER_PAUSE_MS;
+        if (elapsed >= next) {
+            next += GAME_OVER_HIGHLIGHT_MS;
+        }
+        if (elapsed >= next) {
+            next += GAME_OVER_MESSAGE_MS;
+        }
+        return elapsed < next ? (int)(next - elapsed) : 0;
+    }
+    return -1;
+}
+
+// Função para saber se o mouse controla a próxima jogada (no modo contra o computador, só na vez do jogador 1).
+bool humanTurn(const Game* game) {
+    return !game->gameOver && !game->isDropping && (!game->vsComputer || game->currentPlayer == PLAYER1);
+}
@@ -0,0 +1,67 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include <SDL2/SDL.h>
+#include <time.h>
+#include "variant.h"
+
+// Estado de uma partida na interface e as telas por onde o jogo passa, sem nada de desenho (ver render.h).
+
+#define FRAME_INTERVAL_MS 16 // Intervalo entre quadros durante animações
+#define GAME_OVER_PAUSE_MS 500 // Tabuleiro final parado antes do destaque
+#define GAME_OVER_HIGHLIGHT_MS 1500 // Destaque da sequência vencedora
+#define GAME_OVER_MESSAGE_MS 3000 // Mensagem com o resultado, antes da pergunta de reinício
+
+typedef struct {
+    const BoardVariant* variant;  // Tamanho do tabuleiro escolhido ao iniciar
+    BoardState position;  // Tabuleiro em bitboard, interpretado pelas funções da variante
+    Player currentPlayer;
+    bool gameOver;
+    Player winner;
+    bool vsComputer;
+    int selectedCol;
+    bool isDropping;
+    int dropRow;
+    int dropY;
+    Uint32 dropStartTicks;  // Início da animação de queda (SDL_GetTicks)
+    SDL_Point winningSequence[4];  // Coordenadas das peças vencedoras
+    uint8_t history[VARIANT_MAX_ROWS * VARIANT_MAX_COLS];  // Colunas jogadas, para o registro de partidas
+    int historyLength;
+    time_t startTime;
+} Game;
+
+// Telas do jogo. Todas são conduzidas pelo laço principal: cada uma só reage a eventos e ao relógio, e
+// nenhuma bloqueia o laço; sem animação nem transição pendente, o laço dorme em SDL_WaitEvent.
+typedef enum {
+    SCENE_TITLE,      // Escolha do modo de jogo
+    SCENE_PLAYING,
+    SCENE_GAME_OVER,  // Tabuleiro final, destaque da sequência vencedora e resultado, em etapas temporizadas
+    SCENE_RESTART     // Pergunta se o jogador quer jogar de novo
+} SceneId;
+
+// Etapas da tela final, na ordem em que aparecem.
+typedef enum {
+    GAME_OVER_BOARD,
+    GAME_OVER_HIGHLIGHT,
+    GAME_OVER_MESSAGE,
+    GAME_OVER_DONE
+} GameOverStage;
+
+typedef struct {
+    SceneId id;
+    Uint32 enteredTicks;  // Entrada na cena (SDL_GetTicks); as transições temporizadas contam a partir daqui
+    GameOverStage stage;  // Etapa da tela final desenhada por último
+} Scene;
+
+void initGame(Game* game, const BoardVariant* variant, bool vsComputer);
+bool dropPiece(Game* game, int col);
+Player checkVictory(Game* game);
+bool boardFull(const Game* game);
+void switchPlayer(Game* game);
+void playMove(Game* game, int col);
+void enterScene(Scene* scene, SceneId id);
+GameOverStage gameOverStage(Uint32 elapsed);
+int sceneTimeout(const Scene* scene, const Game* game);
+bool humanTurn(const Game* game);
+
+#endif
@@ -0,0 +1,145 @@
+#include "gamelog.h"
+#include <string.h>
+#include "mapfile.h"
+
+static void putU16(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void putU32(uint8_t* out, uint32_t value) {
+    putU16(out, value);
+    putU16(out + 2, value >> 16);
+}
+
+static uint32_t getU16(const uint8_t* in) {
+    return (uint32_t)in[0] | (uint32_t)in[1] << 8;
+}
+
+static uint32_t getU32(const uint8_t* in) {
+    return getU16(in) | getU16(in + 2) << 16;
+}
+
+// Bytes ocupados pelas jogadas de um registro.
+static size_t movesSize(int moveCount, int cols) {
+    return ((size_t)moveCount * (size_t)gameLogMoveBits(cols) + 7) / 8;
+}
+
+bool gameLogWriterOpen(GameLogWriter* writer, const char* path) {
+    *writer = (GameLogWriter){0};
+    writer->file = fopen(path, "ab");
+    if (!writer->file) {
+        return false;
+    }
+    // Arquivo novo: grava o cabeçalho antes do primeiro registro
+    if (fseek(writer->file, 0, SEEK_END) == 0 && ftell(writer->file) == 0) {
+        uint8_t header[GAMELOG_FILE_HEADER_SIZE] = {0};
+        memcpy(header, GAMELOG_MAGIC, 4);
+        putU16(header + 4, GAMELOG_VERSION);
+        if (fwrite(header, sizeof(header), 1, writer->file) != 1) {
+            fclose(writer->file);
+            writer->file = nullptr;
+            return false;
+        }
+    }
+    mtx_init(&writer->lock, mtx_plain);
+    return true;
+}
+
+void gameLogWriterClose(GameLogWriter* writer) {
+    if (writer->file) {
+        fclose(writer->file);
+        mtx_destroy(&writer->lock);
+    }
+    *writer = (GameLogWriter){0};
+}
+
+bool gameLogWrite(GameLogWriter* writer, const GameRecord* record) {
+    if (!writer->file || record->moveCount > GAMELOG_MAX_MOVES || record->cols > 15 || record->rows > 15) {
+        return false;
+    }
+    // Um byte a mais: cada jogada é escrita em dois bytes, e a última pode transbordar para o seguinte
+    uint8_t buffer[GAMELOG_RECORD_HEADER_SIZE + GAMELOG_MAX_MOVES / 2 + 1] = {0};
+    buffer[0] = (uint8_t)record->moveCount;
+    buffer[1] = (uint8_t)(record->cols << 4 | record->rows);
+    buffer[2] = (uint8_t)(record->outcome | record->vsComputer << 2 | record->usedBook << 3);
+    buffer[3] = (uint8_t)(record->aiThreads > 0xFF ? 0xFF : record->aiThreads);
+    putU32(buffer + 4, (uint32_t)record->startTime);
+    putU16(buffer + 8, record->durationSeconds > 0xFFFF ? 0xFFFF : record->durationSeconds);
+    putU16(buffer + 10, record->aiTimeLimitMs > 0xFFFF ? 0xFFFF : record->aiTimeLimitMs);
+
+    int bits = gameLogMoveBits(record->cols);
+    uint8_t* moves = buffer + GAMELOG_RECORD_HEADER_SIZE;
+    for (int i = 0; i < record->moveCount; ++i) {
+        int bit = i * bits;
+        uint32_t value = (uint32_t)record->moves[i] << (bit % 8);
+        moves[bit / 8] |= (uint8_t)value;
+        moves[bit / 8 + 1] |= (uint8_t)(value >> 8);
+    }
+
+    size_t size = GAMELOG_RECORD_HEADER_SIZE + movesSize(record->moveCount, record->cols);
+    mtx_lock(&writer->lock);
+    bool ok = fwrite(buffer, size, 1, writer->file) == 1 && fflush(writer->file) == 0;
+    mtx_unlock(&writer->lock);
+    return ok;
+}
+
+bool gameLogReaderOpen(GameLogReader* reader, const char* path) {
+    *reader = (GameLogReader){0};
+    size_t size;
+    void* data = mapFile(path, &size);
+    if (!data) {
+        return false;
+    }
+    if (size < GAMELOG_FILE_HEADER_SIZE || memcmp(data, GAMELOG_MAGIC, 4) != 0 ||
+        getU16((const uint8_t*)data + 4) != GAMELOG_VERSION) {
+        unmapFile(data, size);
+        return false;
+    }
+    mapFileSequential(data, size);
+    reader->data = data;
+    reader->size = size;
+    reader->offset = GAMELOG_FILE_HEADER_SIZE;
+    reader->mapping = data;
+    return true;
+}
+
+void gameLogReaderClose(GameLogReader* reader) {
+    if (reader->mapping) {
+        unmapFile(reader->mapping, reader->size);
+    }
+    *reader = (GameLogReader){0};
+}
+
+bool gameLogNext(GameLogReader* reader, GameRecord* record) {
+    if (reader->size - reader->offset < GAMELOG_RECORD_HEADER_SIZE) {
+        return false;
+    }
+    const uint8_t* in = reader->data + reader->offset;
+    record->moveCount = in[0];
+    record->cols = in[1] >> 4;
+    record->rows = in[1] & 0xF;
+    record->outcome = (GameOutcome)(in[2] & 3);
+    record->vsComputer = (in[2] >> 2 & 1) != 0;
+    record->usedBook = (in[2] >> 3 & 1) != 0;
+    record->aiThreads = in[3];
+    record->startTime = getU32(in + 4);
+    record->durationSeconds = getU16(in + 8);
+    record->aiTimeLimitMs = getU16(in + 10);
+
+    size_t size = GAMELOG_RECORD_HEADER_SIZE + movesSize(record->moveCount, record->cols);
+    if (record->moveCount > GAMELOG_MAX_MOVES || reader->size - reader->offset < size) {
+        return false;
+    }
+    int bits = gameLogMoveBits(record->cols);
+    const uint8_t* moves = in + GAMELOG_RECORD_HEADER_SIZE;
+    const uint8_t* end = in + size;
+    for (int i = 0; i < record->moveCount; ++i) {
+        int bit = i * bits;
+        const uint8_t* byte = moves + bit / 8;
+        uint32_t value = byte[0] | (byte + 1 < end ? (uint32_t)byte[1] << 8 : 0);
+        record->moves[i] = (uint8_t)(value >> (bit % 8) & ((1u << bits) - 1));
+    }
+    reader->offset += size;
+    return true;
+}
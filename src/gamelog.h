@@ -0,0 +1,82 @@
+#ifndef GAMELOG_H
+#define GAMELOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <threads.h>
+
+// Registro binário compacto de partidas terminadas, gravado por acréscimo.
+// Formato (inteiros em little-endian):
+//   cabeçalho do arquivo: "C4GL", versão (uint16), 2 bytes reservados
+//   registros em sequência, cada um com 12 bytes fixos seguidos das jogadas:
+//     uint8   número de jogadas
+//     uint8   tamanho do tabuleiro (colunas << 4 | linhas)
+//     uint8   resultado (bits 0-1: GameOutcome), bit 2: contra o computador, bit 3: livro de aberturas
+//     uint8   threads de busca do computador
+//     uint32  início da partida (segundos desde 1970)
+//     uint16  duração em segundos
+//     uint16  tempo por jogada do computador em milissegundos
+//     jogadas: colunas empacotadas com 3 bits cada (4 bits em tabuleiros com mais de 8 colunas),
+//              do bit menos significativo do primeiro byte em diante
+// Uma partida completa no tabuleiro padrão ocupa 12 + 16 bytes.
+
+#define GAMELOG_MAGIC "C4GL"
+#define GAMELOG_VERSION 1
+#define GAMELOG_FILE_HEADER_SIZE 8
+#define GAMELOG_RECORD_HEADER_SIZE 12
+#define GAMELOG_MAX_MOVES 128
+
+typedef enum {
+    OUTCOME_DRAW = 0,
+    OUTCOME_PLAYER1,       // Vitória do jogador 1
+    OUTCOME_PLAYER2,       // Vitória do jogador 2
+    OUTCOME_ABANDONED      // Partida interrompida antes do fim
+} GameOutcome;
+
+typedef struct {
+    int cols;
+    int rows;
+    int moveCount;
+    uint8_t moves[GAMELOG_MAX_MOVES];  // Colunas jogadas, a partir de 0
+    GameOutcome outcome;
+    bool vsComputer;
+    bool usedBook;
+    int aiThreads;
+    uint32_t aiTimeLimitMs;
+    uint64_t startTime;    // Segundos desde 1970
+    uint32_t durationSeconds;
+} GameRecord;
+
+// Arquivo aberto para acréscimo; várias threads podem gravar no mesmo arquivo.
+typedef struct {
+    FILE* file;
+    mtx_t lock;
+} GameLogWriter;
+
+// Função para abrir (ou criar) um registro para acréscimo.
+bool gameLogWriterOpen(GameLogWriter* writer, const char* path);
+void gameLogWriterClose(GameLogWriter* writer);
+// Função para acrescentar uma partida; cada registro é enviado ao arquivo por inteiro.
+bool gameLogWrite(GameLogWriter* writer, const GameRecord* record);
+
+// Registro mapeado na memória para leitura sequencial, sem carregar as partidas de uma vez.
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t offset;         // Início do próximo registro
+    void* mapping;
+} GameLogReader;
+
+// Função para abrir um registro para leitura; devolve false se o arquivo não existe ou não é um registro.
+bool gameLogReaderOpen(GameLogReader* reader, const char* path);
+void gameLogReaderClose(GameLogReader* reader);
+// Função para decodificar o próximo registro; devolve false no fim do arquivo ou em um registro truncado.
+bool gameLogNext(GameLogReader* reader, GameRecord* record);
+
+// Bits usados por jogada em um tabuleiro com o número de colunas dado.
+static inline int gameLogMoveBits(int cols) {
+    return cols <= 8 ? 3 : 4;
+}
+
+#endif
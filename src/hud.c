@@ -0,0 +1,134 @@
+#include "hud.h"
+#include <stdio.h>
+#include "profile.h"
+
+#define ATLAS_WIDTH 512
+#define HUD_MARGIN 6
+
+bool glyphAtlasInit(SDL_Renderer* renderer, GlyphAtlas* atlas, TTF_Font* font) {
+    *atlas = (GlyphAtlas){0};
+    if (!font) {
+        return false;
+    }
+    atlas->lineHeight = TTF_FontHeight(font);
+
+    // Primeiro rasteriza cada caractere e calcula sua posição, quebrando linhas na largura do atlas
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* glyphs[HUD_GLYPH_COUNT] = {0};
+    int x = 0;
+    int y = 0;
+    for (int i = 0; i < HUD_GLYPH_COUNT; ++i) {
+        char text[2] = {(char)(HUD_FIRST_GLYPH + i), '\0'};
+        glyphs[i] = TTF_RenderText_Blended(font, text, white);
+        if (!glyphs[i]) {
+            continue;
+        }
+        if (x + glyphs[i]->w > ATLAS_WIDTH) {
+            x = 0;
+            y += atlas->lineHeight;
+        }
+        atlas->glyphs[i] = (SDL_Rect){x, y, glyphs[i]->w, glyphs[i]->h};
+        x += glyphs[i]->w;
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, y + atlas->lineHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (surface) {
+        for (int i = 0; i < HUD_GLYPH_COUNT; ++i) {
+            if (glyphs[i]) {
+                SDL_SetSurfaceBlendMode(glyphs[i], SDL_BLENDMODE_NONE);  // Copia também o canal alfa
+                SDL_BlitSurface(glyphs[i], nullptr, surface, &atlas->glyphs[i]);
+            }
+        }
+        atlas->texture = SDL_CreateTextureFromSurface(renderer, surface);
+        SDL_FreeSurface(surface);
+    }
+    for (int i = 0; i < HUD_GLYPH_COUNT; ++i) {
+        if (glyphs[i]) {
+            SDL_FreeSurface(glyphs[i]);
+        }
+    }
+    if (!atlas->texture) {
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void glyphAtlasFree(GlyphAtlas* atlas) {
+    if (atlas->texture) {
+        SDL_DestroyTexture(atlas->texture);
+    }
+    *atlas = (GlyphAtlas){0};
+}
+
+int glyphAtlasDraw(SDL_Renderer* renderer, const GlyphAtlas* atlas, int x, int y, const char* text) {
+    int startX = x;
+    for (const char* c = text; *c; ++c) {
+        int index = (unsigned char)*c - HUD_FIRST_GLYPH;
+        if (index < 0 || index >= HUD_GLYPH_COUNT || atlas->glyphs[index].w == 0) {
+            continue;
+        }
+        const SDL_Rect* source = &atlas->glyphs[index];
+        SDL_Rect target = {x, y, source->w, source->h};
+        SDL_RenderCopy(renderer, atlas->texture, source, &target);
+        x += source->w;
+    }
+    return x - startX;
+}
+
+void hudDraw(SDL_Renderer* renderer, const GlyphAtlas* atlas, const HudTimings* timings) {
+    if (!atlas->texture) {
+        return;
+    }
+    FrameStats frames = profileFrameStats();
+    SearchStats search = profileSearchStats();
+
+    char lines[5][96];
+    snprintf(lines[0], sizeof(lines[0]), "frame p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms (%d)",
+             frames.p50 / 1000.0, frames.p95 / 1000.0, frames.p99 / 1000.0, frames.max / 1000.0, frames.count);
+    snprintf(lines[1], sizeof(lines[1]), "events %.2f  drawBoard %.2f  displayTurn %.2f ms",
+             timings->eventsUs / 1000.0, timings->boardUs / 1000.0, timings->turnUs / 1000.0);
+    if (search.fromBook) {
+        snprintf(lines[2], sizeof(lines[2]), "search #%llu: opening book", (unsigned long long)search.searches);
+    } else if (search.fromEndgame) {
+        snprintf(lines[2], sizeof(lines[2]), "search #%llu: endgame table", (unsigned long long)search.searches);
+    } else if (search.playouts) {
+        snprintf(lines[2], sizeof(lines[2]), "search #%llu: mcts depth %d  %.1f ms", (unsigned long long)search.searches,
+                 search.depth, search.elapsedUs / 1000.0);
+    } else {
+        snprintf(lines[2], sizeof(lines[2]), "search #%llu: depth %d  %.1f ms", (unsigned long long)search.searches,
+                 search.depth, search.elapsedUs / 1000.0);
+    }
+    if (search.playouts) {
+        snprintf(lines[3], sizeof(lines[3]), "playouts %llu  %.2f M/s  tree nodes %llu",
+                 (unsigned long long)search.playouts, search.playoutsPerSecond / 1e6, (unsigned long long)search.nodes);
+    } else {
+        snprintf(lines[3], sizeof(lines[3]), "nodes %llu  %.2f Mnodes/s  TT hits %.1f%%",
+                 (unsigned long long)search.nodes, search.nodesPerSecond / 1e6, search.ttHitRate * 100.0);
+    }
+    if (profileRecording()) {
+        snprintf(lines[4], sizeof(lines[4]), "trace: recording (%zu events, F4 stops)", profileEventCount());
+    } else {
+        snprintf(lines[4], sizeof(lines[4]), "trace: off (F4 records)");
+    }
+
+    SDL_Rect background = {0, 0, 0, 5 * atlas->lineHeight + 2 * HUD_MARGIN};
+    for (int i = 0; i < 5; ++i) {
+        int width = 0;
+        for (const char* c = lines[i]; *c; ++c) {
+            int index = (unsigned char)*c - HUD_FIRST_GLYPH;
+            width += (index >= 0 && index < HUD_GLYPH_COUNT) ? atlas->glyphs[index].w : 0;
+        }
+        if (width + 2 * HUD_MARGIN > background.w) {
+            background.w = width + 2 * HUD_MARGIN;
+        }
+    }
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
+    SDL_RenderFillRect(renderer, &background);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    for (int i = 0; i < 5; ++i) {
+        glyphAtlasDraw(renderer, atlas, HUD_MARGIN, HUD_MARGIN + i * atlas->lineHeight, lines[i]);
+    }
+}
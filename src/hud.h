@@ -0,0 +1,39 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdint.h>
+
+// Sobreposição de desempenho (F3): tempos dos quadros, do tratamento de eventos e do desenho, e os
+// números da última busca do computador. O texto muda a cada quadro, então em vez de rasterizar cada
+// linha com a SDL_ttf ele é montado com cópias de um atlas com os caracteres ASCII imprimíveis,
+// rasterizados uma vez.
+
+#define HUD_FIRST_GLYPH 32
+#define HUD_GLYPH_COUNT 95  // ' ' até '~'
+
+typedef struct {
+    SDL_Texture* texture;
+    SDL_Rect glyphs[HUD_GLYPH_COUNT];  // Posição de cada caractere na textura
+    int lineHeight;
+} GlyphAtlas;
+
+// Tempos (em microssegundos) das etapas do último quadro desenhado.
+typedef struct {
+    uint64_t eventsUs;
+    uint64_t boardUs;
+    uint64_t turnUs;
+} HudTimings;
+
+// Função para rasterizar o atlas de caracteres com uma fonte (na inicialização ou após a perda das texturas).
+bool glyphAtlasInit(SDL_Renderer* renderer, GlyphAtlas* atlas, TTF_Font* font);
+void glyphAtlasFree(GlyphAtlas* atlas);
+
+// Função para desenhar uma linha de texto ASCII a partir do atlas; devolve a largura desenhada.
+int glyphAtlasDraw(SDL_Renderer* renderer, const GlyphAtlas* atlas, int x, int y, const char* text);
+
+// Função para desenhar a sobreposição no canto superior esquerdo.
+void hudDraw(SDL_Renderer* renderer, const GlyphAtlas* atlas, const HudTimings* timings);
+
+#endif
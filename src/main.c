@@ -1,112 +1,254 @@
 #include <SDL2/SDL.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <SDL2/SDL_ttf.h>
-
-#define ROWS 6
-#define COLS 7
-#define TILE_SIZE 100
-#define WINDOW_WIDTH (COLS * TILE_SIZE)
-#define WINDOW_HEIGHT (ROWS * TILE_SIZE + 100)  // Altura extra para a peça suspensa
-#define CIRCLE_RADIUS (TILE_SIZE / 2 - 10)
-#define DROP_SPEED 60 // Velocidade da queda da peça
-#define HIGHLIGHT_POSITION (TILE_SIZE / 2 - 50)
-
-typedef enum {
-    NONE = 0,
-    PLAYER1,
-    PLAYER2
-} Player;
-
-typedef struct {
-    Player board[ROWS][COLS];
-    Player currentPlayer;
-    bool gameOver;
-    Player winner;
-    bool vsComputer;
-    int selectedCol;
-    bool isDropping;
-    int dropRow;
-    int dropY;
-    SDL_Point winningSequence[4];  // Coordenadas das peças vencedoras
-} Game;
-
+#include "aiworker.h"
+#include "gamelog.h"
+#include "game.h"
+#include "hud.h"
+#include "profile.h"
+#include "render.h"
+#include "search.h"
+#include "variant.h"
+
+#define DROP_SPEED 3.6f // Velocidade da queda da peça, em pixels por milissegundo
+#define AI_TIME_LIMIT_MS 500 // Tempo máximo de busca por jogada do computador
+#define AI_TT_MEGABYTES 64 // Memória da tabela de transposição da IA
+#define AI_MCTS_MEGABYTES 128 // Arena de nós do MCTS (só com --mcts)
+#define AI_BOOK_PATH "opening.book" // Livro de aberturas gerado por c4bookgen (opcional)
+#define AI_ENDGAME_PATH "endgame.db" // Banco de finais gerado por c4endgamegen (opcional)
+#define HUD_FONT_SIZE 14 // Fonte da sobreposição de desempenho (F3)
+#define TRACE_PATH "c4trace.json" // Trace gravado com F4 (a variável de ambiente C4_TRACE muda o caminho)
+#define GAME_LOG_PATH "games.log" // Registro das partidas jogadas, lido por c4replay
+#ifdef _WIN32
+#define FONT_PATH "C:\\Windows\\Fonts\\arial.ttf" // Caminho para Windows
+#else
+#define FONT_PATH "/usr/share/fonts/truetype/msttcorefonts/Arial.ttf" // Caminho para Linux
+#endif
 
 // Funções principais do jogo
-void initSDL(SDL_Window** window, SDL_Renderer** renderer);
+void initSDL(SDL_Window** window, SDL_Renderer** renderer, const BoardVariant* variant);
 void cleanupSDL(SDL_Window* window, SDL_Renderer* renderer);
-void initGame(Game* game, bool vsComputer);
-void drawBoard(SDL_Renderer* renderer, const Game* game);
-bool dropPiece(Game* game, int col);
-bool checkDirection(const Game* game, int row, int col, int dRow, int dCol, SDL_Point* sequence);
-Player checkVictory(Game* game);
-bool boardFull(const Game* game);
-void switchPlayer(Game* game);
-int computerMove(Game* game);
-void playMove(Game* game, int col);
-void showEndGameScreen(SDL_Renderer* renderer, Game* game, TTF_Font* font);
-void drawCircle(SDL_Renderer* renderer, int centerX, int centerY, int radius, SDL_Color color);
-void displayTurn(SDL_Renderer* renderer, const Game* game, TTF_Font* font);
-bool showRestartPrompt(SDL_Renderer* renderer, TTF_Font* font);
-int findWinningMove(Game* game, Player player);
-void drawButton(SDL_Renderer* renderer, TTF_Font* font, SDL_Rect buttonRect, const char* buttonText);
+void logGame(GameLogWriter* log, const Game* game, bool abandoned, const Engine* engine, const SearchLimits* limits);
 
 int main(int argc, char* args[]) {
     SDL_Window* window = nullptr;
     SDL_Renderer* renderer = nullptr;
 
+    // O tamanho do tabuleiro pode ser escolhido na linha de comando ("TF 9x7"); o padrão é 7x6. Com
+    // "--mcts" o computador joga com o MCTS em vez da busca alfa-beta
+    const BoardVariant* variant = boardVariants[0];
+    bool useMcts = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(args[i], "--mcts") == 0) {
+            useMcts = true;
+            continue;
+        }
+        variant = variantFind(args[i]);
+        if (!variant) {
+            printf("Tabuleiro não suportado: %s. Opções:", args[i]);
+            for (size_t j = 0; j < boardVariantCount; ++j) {
+                printf(" %s", boardVariants[j]->name);
+            }
+            printf("\n");
+            return 1;
+        }
+    }
+
     // Inicializa SDL e SDL_ttf
     if (SDL_Init(SDL_INIT_VIDEO) < 0 || TTF_Init() == -1) {
         printf("Erro ao inicializar SDL ou SDL_ttf: %s\n", SDL_GetError());
         return 1;
     }
 
-    TTF_Font* font;
-#ifdef _WIN32
-    font = TTF_OpenFont("C:\\Windows\\Fonts\\arial.ttf", 24); // Caminho para Windows
-#else
-    font = TTF_OpenFont("/usr/share/fonts/truetype/msttcorefonts/Arial.ttf", 24); // Caminho para Linux
-#endif
+    TTF_Font* font = TTF_OpenFont(FONT_PATH, 24);
+    TTF_Font* hudFont = TTF_OpenFont(FONT_PATH, HUD_FONT_SIZE);
 
     if (!font) {
         printf("Erro ao carregar a fonte: %s\n", TTF_GetError());
         // Trate o erro conforme necessário
     }
 
-    initSDL(&window, &renderer);
-    SDL_SetHint(SDL_HINT_RENDER_VSYNC, "1"); // Ativa VSync para sincronizar com o monitor
+    Engine engine;
+    if (!engineInit(&engine, AI_TT_MEGABYTES)) {
+        printf("Erro ao alocar a tabela de transposição (%d MB)\n", AI_TT_MEGABYTES);
+        return 1;
+    }
+    OpeningBook book;
+    if (variant->openBook(&book, AI_BOOK_PATH)) {
+        engine.book = &book;
+        printf("Livro de aberturas carregado: %zu posições.\n", book.count);
+    }
+    Mcts mcts = {0};
+    if (useMcts) {
+        if (!variant->initMcts(&mcts, AI_MCTS_MEGABYTES)) {
+            printf("Erro ao alocar a árvore do MCTS (%d MB)\n", AI_MCTS_MEGABYTES);
+            return 1;
+        }
+        printf("Computador jogando com MCTS.\n");
+    }
+    EndgameTable endgame;
+    if (variant->openEndgame(&endgame, AI_ENDGAME_PATH)) {
+        engine.endgame = &endgame;
+        printf("Banco de finais carregado: %zu posições com até %d casas vazias.\n", endgame.count,
+               endgame.maxEmpty);
+    }
+
+    SDL_SetHint(SDL_HINT_RENDER_VSYNC, "1"); // Ativa VSync para sincronizar com o monitor (antes de criar o renderizador)
+    initSDL(&window, &renderer, variant);
+
+    RenderCache cache;
+    if (!initRenderCache(renderer, &cache, variant)) {
+        printf("Erro ao criar as texturas das peças: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    // O computador joga em uma thread separada, com tempo limitado para a resposta ficar previsível
+    SearchLimits aiLimits = {.timeLimitMs = AI_TIME_LIMIT_MS, .threads = SDL_GetCPUCount()};
+    AiWorker ai;
+    if (!aiWorkerStart(&ai, &engine, useMcts ? &mcts : nullptr, variant, &aiLimits)) {
+        printf("Erro ao iniciar a thread da IA: %s\n", SDL_GetError());
+        return 1;
+    }
+    bool aiThinking = false;  // Há um pedido de jogada cuja resposta ainda não chegou
+    Uint32 aiGeneration = 0;  // Geração do pedido em andamento
+
+    // Instrumentação: F3 mostra a sobreposição de desempenho e F4 liga ou desliga a gravação do trace.
+    // Com C4_TRACE definida, a gravação começa já na abertura e o trace é gravado nesse caminho ao sair.
+    const char* tracePath = SDL_getenv("C4_TRACE");
+    if (tracePath && profileStartRecording()) {
+        printf("Gravando trace de desempenho em %s\n", tracePath);
+    } else {
+        tracePath = TRACE_PATH;
+    }
+    GlyphAtlas hudAtlas;
+    glyphAtlasInit(renderer, &hudAtlas, hudFont);
+
+    // As partidas terminadas (e as interrompidas ao fechar a janela) são acrescentadas ao registro
+    GameLogWriter gameLog;
+    GameLogWriter* log = gameLogWriterOpen(&gameLog, GAME_LOG_PATH) ? &gameLog : nullptr;
+    if (!log) {
+        printf("Aviso: não foi possível abrir o registro de partidas %s\n", GAME_LOG_PATH);
+    }
+    bool showHud = false;
+    HudTimings timings = {0};
 
     Game game;
-    initGame(&game, true); // Inicia o jogo no modo jogador vs computador
+    initGame(&game, variant, true);
+    Scene scene;
+    enterScene(&scene, SCENE_TITLE);
 
     bool quit = false;
+    bool dirty = true;  // O estado mudou e a tela precisa ser redesenhada
     SDL_Event e;
 
     while (!quit) {
-        Uint32 startTick = SDL_GetTicks();
+        if (scene.id == SCENE_PLAYING && game.vsComputer && game.currentPlayer == PLAYER2 && !game.gameOver &&
+            !game.isDropping && !aiThinking) {
+            aiGeneration = aiRequestMove(&ai, &game.position);
+            aiThinking = true;
+        }
 
-        while (SDL_PollEvent(&e) != 0) {
+        // O laço dorme até o próximo evento (a jogada do computador também chega como evento) ou até a
+        // próxima transição temporizada da cena; durante a queda de uma peça acorda a cada quadro
+        bool hasEvent = SDL_WaitEventTimeout(&e, sceneTimeout(&scene, &game));
+
+        uint64_t frameStart = profileBegin();
+        while (hasEvent) {
             if (e.type == SDL_QUIT) {
                 quit = true;
-            } else if (e.type == SDL_MOUSEMOTION && !game.gameOver && !game.isDropping && game.currentPlayer == PLAYER1) {
-                game.selectedCol = e.motion.x / TILE_SIZE;
-            } else if (e.type == SDL_MOUSEBUTTONDOWN && !game.gameOver && !game.isDropping && game.currentPlayer == PLAYER1) {
+            } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F3) {
+                showHud = !showHud;
+                dirty = true;
+            } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F4) {
+                if (!profileRecording()) {
+                    profileStartRecording();
+                } else {
+                    profileStopRecording();
+                    if (profileWriteTrace(tracePath)) {
+                        printf("Trace de desempenho gravado em %s (%zu eventos)\n", tracePath, profileEventCount());
+                    } else {
+                        printf("Erro ao gravar o trace em %s\n", tracePath);
+                    }
+                }
+                dirty = true;
+            } else if (e.type == ai.eventType) {
+                // Respostas de pedidos cancelados (jogo reiniciado ou terminado) são ignoradas
+                if (scene.id == SCENE_PLAYING && aiThinking && (Uint32)(uintptr_t)e.user.data1 == aiGeneration) {
+                    aiThinking = false;
+                    playMove(&game, e.user.code);
+                    if (!game.gameOver) {
+                        aiPonder(&ai, &game.position);  // Prepara as respostas enquanto o humano pensa
+                    }
+                    dirty = true;
+                }
+            } else if (e.type == SDL_WINDOWEVENT) {
+                dirty = true;
+            } else if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) {
+                // O conteúdo das texturas de destino foi perdido: recria o cache
+                freeRenderCache(&cache);
+                if (!initRenderCache(renderer, &cache, variant)) {
+                    printf("Erro ao recriar as texturas das peças: %s\n", SDL_GetError());
+                    quit = true;
+                }
+                glyphAtlasFree(&hudAtlas);
+                glyphAtlasInit(renderer, &hudAtlas, hudFont);
+                dirty = true;
+            } else if (scene.id == SCENE_TITLE && e.type == SDL_MOUSEBUTTONDOWN) {
+                int choice = promptButtonAt(variant, e.button.x, e.button.y);
+                if (choice >= 0) {
+                    initGame(&game, variant, choice == 0);
+                    if (game.vsComputer) {
+                        aiPonder(&ai, &game.position);
+                    }
+                    enterScene(&scene, SCENE_PLAYING);
+                    dirty = true;
+                }
+            } else if (scene.id == SCENE_PLAYING && e.type == SDL_MOUSEMOTION && humanTurn(&game)) {
+                int col = e.motion.x / TILE_SIZE;
+                if (col != game.selectedCol) {
+                    game.selectedCol = col;
+                    dirty = true;
+                }
+            } else if (scene.id == SCENE_PLAYING && e.type == SDL_MOUSEBUTTONDOWN && humanTurn(&game)) {
                 int col = e.button.x / TILE_SIZE;
-                if (game.board[0][col] == NONE) {
+                if (variant->canPlay(&game.position, col)) {
+                    game.selectedCol = col;
                     game.isDropping = true;
-                    game.dropRow = ROWS - 1;
-                    while (game.dropRow >= 0 && game.board[game.dropRow][col] != NONE) {
-                        game.dropRow--;
-                    }
+                    game.dropRow = variant->landingRow(&game.position, col);
+                    game.dropStartTicks = SDL_GetTicks();
                     game.dropY = 50;
+                    dirty = true;
+                }
+            } else if (scene.id == SCENE_GAME_OVER && e.type == SDL_MOUSEBUTTONDOWN) {
+                // Um clique pula direto para a pergunta de reinício
+                enterScene(&scene, SCENE_RESTART);
+                dirty = true;
+            } else if (scene.id == SCENE_RESTART && e.type == SDL_MOUSEBUTTONDOWN) {
+                int choice = promptButtonAt(variant, e.button.x, e.button.y);
+                if (choice == 0) {
+                    initGame(&game, variant, game.vsComputer);
+                    if (game.vsComputer) {
+                        aiPonder(&ai, &game.position);
+                    }
+                    enterScene(&scene, SCENE_PLAYING);
+                    dirty = true;
+                } else if (choice == 1) {
+                    quit = true;
                 }
             }
+            hasEvent = SDL_PollEvent(&e);
         }
+        timings.eventsUs = profileEnd("events", frameStart);
 
-        if (game.isDropping) {
-            game.dropY += DROP_SPEED;
+        if (scene.id == SCENE_PLAYING && game.isDropping) {
+            // A posição da peça depende do tempo decorrido, não do número de quadros desenhados
+            Uint32 elapsed = SDL_GetTicks() - game.dropStartTicks;
+            game.dropY = 50 + (int)(elapsed * DROP_SPEED);
+            dirty = true;
             if (game.dropY >= (game.dropRow * TILE_SIZE + 50)) {
-                game.board[game.dropRow][game.selectedCol] = game.currentPlayer;
+                dropPiece(&game, game.selectedCol);
                 game.isDropping = false;
                 game.dropY = 0;
 
@@ -122,148 +264,71 @@ int main(int argc, char* args[]) {
             }
         }
 
-        if (game.vsComputer && game.currentPlayer == PLAYER2 && !game.gameOver && !game.isDropping) {
-            SDL_Delay(100); // Reduz o delay para uma atualização mais dinâmica
-            int col = computerMove(&game);
-            playMove(&game, col);
+        // Transições da cena: o fim da partida e as etapas da tela final, pelo tempo decorrido
+        if (scene.id == SCENE_PLAYING && game.gameOver) {
+            aiCancel(&ai);  // Interrompe a ponderação sobre uma posição que não vai mais acontecer
+            aiThinking = false;
+            logGame(log, &game, false, &engine, &aiLimits);
+            enterScene(&scene, SCENE_GAME_OVER);
+            dirty = true;
+        } else if (scene.id == SCENE_GAME_OVER) {
+            GameOverStage stage = gameOverStage(SDL_GetTicks() - scene.enteredTicks);
+            if (stage == GAME_OVER_DONE) {
+                enterScene(&scene, SCENE_RESTART);
+                dirty = true;
+            } else if (stage != scene.stage) {
+                scene.stage = stage;
+                dirty = true;
+            }
         }
 
-        drawBoard(renderer, &game);
-        displayTurn(renderer, &game, font);
+        if (dirty) {
+            drawScene(renderer, &cache, &scene, &game, font, &timings);
 
-        if (game.gameOver) {
-            SDL_Delay(500); // Aguarda uma pausa mais curta
-            showEndGameScreen(renderer, &game, font);
-
-            bool playAgain = showRestartPrompt(renderer, font);
-            if (playAgain) {
-                initGame(&game, game.vsComputer);
-            } else {
-                quit = true;
+            if (showHud) {
+                uint64_t start = profileBegin();
+                hudDraw(renderer, &hudAtlas, &timings);
+                profileEnd("hudDraw", start);
             }
-        }
 
-        Uint32 frameTime = SDL_GetTicks() - startTick;
-        if (frameTime < 4) {
-            SDL_Delay(4 - frameTime); // Limita a atualização real com base no tempo do frame atual
+            uint64_t start = profileBegin();
+            SDL_RenderPresent(renderer);
+            profileEnd("present", start);
+            profileFrame(profileEnd("frame", frameStart));
+            dirty = false;
         }
     }
 
+    aiWorkerStop(&ai);
+    if (!game.gameOver && game.historyLength > 0) {
+        logGame(log, &game, true, &engine, &aiLimits);
+    }
+    if (log) {
+        gameLogWriterClose(log);
+    }
+    if (profileRecording()) {
+        profileStopRecording();
+        if (profileWriteTrace(tracePath)) {
+            printf("Trace de desempenho gravado em %s (%zu eventos)\n", tracePath, profileEventCount());
+        }
+    }
+    glyphAtlasFree(&hudAtlas);
+    freeRenderCache(&cache);
+    if (hudFont) {
+        TTF_CloseFont(hudFont);
+    }
     TTF_CloseFont(font);
     TTF_Quit();
     cleanupSDL(window, renderer);
+    engineFree(&engine);
+    variant->freeMcts(&mcts);
+    variant->closeBook(&book);
+    variant->closeEndgame(&endgame);
     return 0;
 }
 
 
-// Função para exibir uma mensagem de reinício do jogo com opções "Sim" e "Não".
-bool showRestartPrompt(SDL_Renderer* renderer, TTF_Font* font) {
-    const char* message = "Deseja jogar novamente?";
-
-    SDL_Color textColor = {255, 255, 255, 255};
-    SDL_Surface* messageSurface = TTF_RenderText_Solid(font, message, textColor);
-    SDL_Texture* messageTexture = SDL_CreateTextureFromSurface(renderer, messageSurface);
-
-    int messageWidth = messageSurface->w;
-    int messageHeight = messageSurface->h;
-    SDL_FreeSurface(messageSurface);
-
-    SDL_Rect messageRect = {WINDOW_WIDTH / 2 - messageWidth / 2, WINDOW_HEIGHT / 2 - 80, messageWidth, messageHeight};
-    SDL_Rect yesButton = {WINDOW_WIDTH / 2 - 110, WINDOW_HEIGHT / 2, 100, 50};
-    SDL_Rect noButton = {WINDOW_WIDTH / 2 + 10, WINDOW_HEIGHT / 2, 100, 50};
-
-    SDL_RenderClear(renderer);
-    SDL_RenderCopy(renderer, messageTexture, nullptr, &messageRect);
-    drawButton(renderer, font, yesButton, "Sim");
-    drawButton(renderer, font, noButton, "Não");
-    SDL_RenderPresent(renderer);
-
-    SDL_DestroyTexture(messageTexture);  // Libera a textura após uso
-
-    bool selecting = true;
-    bool playAgain = false;
-    while (selecting) {
-        SDL_Event e;
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_QUIT) {
-                selecting = false;
-                playAgain = false;
-            } else if (e.type == SDL_MOUSEBUTTONDOWN) {
-                int x = e.button.x;
-                int y = e.button.y;
-
-                if (x >= yesButton.x && x <= (yesButton.x + yesButton.w) &&
-                    y >= yesButton.y && y <= (yesButton.y + yesButton.h)) {
-                    playAgain = true;
-                    selecting = false;
-                    }
-                if (x >= noButton.x && x <= (noButton.x + noButton.w) &&
-                    y >= noButton.y && y <= (noButton.y + noButton.h)) {
-                    playAgain = false;
-                    selecting = false;
-                    }
-            }
-        }
-    }
-    return playAgain;
-}
-
-void showEndGameScreen(SDL_Renderer* renderer, Game* game, TTF_Font* font) {
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
-
-    SDL_Color highlightColor = {255, 255, 255, 255};
-    for (int i = 0; i < 4; ++i) {
-        int x = game->winningSequence[i].x * TILE_SIZE + TILE_SIZE / 2;
-        int y = game->winningSequence[i].y * TILE_SIZE + TILE_SIZE / 2 + 50;
-        drawCircle(renderer, x, y, CIRCLE_RADIUS, highlightColor);
-    }
-    SDL_RenderPresent(renderer);
-    SDL_Delay(1500);
-
-    const char* message = game->winner == PLAYER1 ? "Jogador 1 venceu!" : "Computador venceu!";
-    SDL_Color textColor = {255, 255, 255, 255};
-    SDL_Surface* textSurface = TTF_RenderText_Solid(font, message, textColor);
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, textSurface);
-
-    int textWidth = textSurface->w;
-    int textHeight = textSurface->h;
-    SDL_Rect textRect = {WINDOW_WIDTH / 2 - textWidth / 2, WINDOW_HEIGHT / 2 + TILE_SIZE, textWidth, textHeight};
-
-    SDL_RenderClear(renderer);
-    SDL_RenderCopy(renderer, texture, nullptr, &textRect);
-    SDL_RenderPresent(renderer);
-
-    // Libera a superfície e textura após uso
-    SDL_FreeSurface(textSurface);
-    SDL_DestroyTexture(texture);
-
-    SDL_Delay(3000);
-}
-
-// Função para exibir de quem é o turno na interface (do jogador ou do computador).
-void displayTurn(SDL_Renderer* renderer, const Game* game, TTF_Font* font) {
-    SDL_Rect messageRect = {0, WINDOW_HEIGHT - 50, WINDOW_WIDTH, 50};
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    SDL_RenderFillRect(renderer, &messageRect);
-
-    SDL_Color textColor = {0, 0, 0, 255};
-    const char* message = game->currentPlayer == PLAYER1 ? "Sua vez!" : "Vez do computador!";
-
-    SDL_Surface* textSurface = TTF_RenderText_Solid(font, message, textColor);
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, textSurface);
-
-    SDL_Rect textRect = {10, WINDOW_HEIGHT - 45, textSurface->w, textSurface->h};
-    SDL_FreeSurface(textSurface);
-
-    SDL_RenderCopy(renderer, texture, nullptr, &textRect);
-    SDL_DestroyTexture(texture);  // Libera a textura após uso
-    SDL_RenderPresent(renderer);
-}
-
-
-
-void initSDL(SDL_Window** window, SDL_Renderer** renderer) {
+void initSDL(SDL_Window** window, SDL_Renderer** renderer, const BoardVariant* variant) {
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         printf("Erro ao inicializar SDL: %s\n", SDL_GetError());
         exit(1);
@@ -271,9 +336,13 @@ void initSDL(SDL_Window** window, SDL_Renderer** renderer) {
 
     // (Opcional) Dica para garantir que o SDL tente usar o driver OpenGL para renderização acelerada
     SDL_SetHint(SDL_HINT_RENDER_DRIVER, "opengl");
+    // Escolher o driver desliga o agrupamento de comandos de desenho por padrão; as cópias de textura
+    // do tabuleiro dependem dele para virar poucas chamadas à GPU
+    SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
 
     // Criação da janela
-    *window = SDL_CreateWindow("Conecta 4", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_SHOWN);
+    *window = SDL_CreateWindow("Conecta 4", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                               WINDOW_WIDTH(variant), WINDOW_HEIGHT(variant), SDL_WINDOW_SHOWN);
     if (!*window) {
         printf("Erro ao criar janela SDL: %s\n", SDL_GetError());
         exit(1);
@@ -303,249 +372,29 @@ void cleanupSDL(SDL_Window* window, SDL_Renderer* renderer) {
     SDL_Quit();
 }
 
-// Função para inicializar o estado do jogo, incluindo a configuração do tabuleiro e do jogador inicial.
-void initGame(Game* game, bool vsComputer) {
-    for (int row = 0; row < ROWS; ++row) {
-        for (int col = 0; col < COLS; ++col) {
-            game->board[row][col] = NONE;
-        }
-    }
-    game->currentPlayer = PLAYER1;
-    game->gameOver = false;
-    game->winner = NONE;
-    game->vsComputer = vsComputer;
-    game->selectedCol = -1;
-    game->isDropping = false;
-    game->dropRow = 0;
-    game->dropY = 0;
-}
-
-// Função auxiliar para desenhar um círculo colorido em uma posição específica (usada para desenhar peças).
-void drawCircle(SDL_Renderer* renderer, int centerX, int centerY, int radius, SDL_Color color) {
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    for (int w = 0; w < radius * 2; w++) {
-        for (int h = 0; h < radius * 2; h++) {
-            int dx = radius - w;
-            int dy = radius - h;
-            if ((dx * dx + dy * dy) <= (radius * radius)) {
-                SDL_RenderDrawPoint(renderer, centerX + dx, centerY + dy);
-            }
-        }
-    }
-}
-
-
-// Função para desenhar o tabuleiro e as peças, incluindo a peça suspensa e a animação de queda.
-void drawBoard(SDL_Renderer* renderer, const Game* game) {
-    SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);  // Fundo azul do tabuleiro
-    SDL_RenderClear(renderer);
-
-    // Desenha a peça suspensa (onde o jogador pretende colocar a peça)
-    if (game->selectedCol >= 0 && game->selectedCol < COLS && !game->isDropping) {
-        int centerX = game->selectedCol * TILE_SIZE + TILE_SIZE / 2;
-        SDL_Color highlightColor = (game->currentPlayer == PLAYER1) ? (SDL_Color){255, 0, 0, 255} : (SDL_Color){255, 255, 0, 255};
-        drawCircle(renderer, centerX, HIGHLIGHT_POSITION, CIRCLE_RADIUS, highlightColor);
-    }
-
-    // Desenha as peças no tabuleiro
-    for (int row = 0; row < ROWS; ++row) {
-        for (int col = 0; col < COLS; ++col) {
-            int centerX = col * TILE_SIZE + TILE_SIZE / 2;
-            int centerY = row * TILE_SIZE + TILE_SIZE / 2 + 50; // Desloca o tabuleiro para baixo
-
-            SDL_Color color;
-            if (game->board[row][col] == PLAYER1) {
-                color = (SDL_Color){255, 0, 0, 255}; // Vermelho
-            } else if (game->board[row][col] == PLAYER2) {
-                color = (SDL_Color){255, 255, 0, 255}; // Amarelo
-            } else {
-                color = (SDL_Color){255, 255, 255, 255}; // Branco
-            }
-            drawCircle(renderer, centerX, centerY, CIRCLE_RADIUS, color);
-        }
-    }
-
-    // Desenha a peça caindo (durante a animação de queda)
-    if (game->isDropping) {
-        int centerX = game->selectedCol * TILE_SIZE + TILE_SIZE / 2;
-        SDL_Color dropColor = (game->currentPlayer == PLAYER1) ? (SDL_Color){255, 0, 0, 255} : (SDL_Color){255, 255, 0, 255};
-        drawCircle(renderer, centerX, game->dropY, CIRCLE_RADIUS, dropColor);
-    }
-
-    SDL_RenderPresent(renderer);
-}
-
-// Função para simular a queda de uma peça em uma coluna específica e atualizar o tabuleiro.
-bool dropPiece(Game* game, int col) {
-    if (col < 0 || col >= COLS || game->board[0][col] != NONE) {
-        return false;
-    }
-    for (int row = ROWS - 1; row >= 0; --row) {
-        if (game->board[row][col] == NONE) {
-            game->board[row][col] = game->currentPlayer;
-            return true;
-        }
-    }
-    return false;
-}
-
-// Função para verificar uma sequência de quatro peças na mesma direção e armazenar a sequência vencedora.
-bool checkDirection(const Game* game, int row, int col, int dRow, int dCol, SDL_Point* sequence) {
-    Player start = game->board[row][col];
-    if (start == NONE) return false;
-
-    for (int i = 0; i < 4; ++i) {
-        int newRow = row + i * dRow;
-        int newCol = col + i * dCol;
-        if (newRow < 0 || newRow >= ROWS || newCol < 0 || newCol >= COLS || game->board[newRow][newCol] != start) {
-            return false;
-        }
-        sequence[i] = (SDL_Point){newCol, newRow};  // Armazena a sequência
-    }
-    return true;
-}
-
-// Função para verificar se um jogador ganhou o jogo, retornando o jogador vencedor ou NONE se não houver vitória.
-Player checkVictory(Game* game) {
-    for (int row = 0; row < ROWS; ++row) {
-        for (int col = 0; col < COLS; ++col) {
-            if (game->board[row][col] != NONE) {
-                if (checkDirection(game, row, col, 1, 0, game->winningSequence) ||  // Vertical
-                    checkDirection(game, row, col, 0, 1, game->winningSequence) ||  // Horizontal
-                    checkDirection(game, row, col, 1, 1, game->winningSequence) ||  // Diagonal descendente
-                    checkDirection(game, row, col, 1, -1, game->winningSequence))   // Diagonal ascendente
-                {
-                    return game->board[row][col];
-                }
-            }
-        }
-    }
-    return NONE;
-}
-
-// Função para verificar se o tabuleiro está completamente preenchido, indicando um empate.
-bool boardFull(const Game* game) {
-    for (int col = 0; col < COLS; ++col) {
-        if (game->board[0][col] == NONE) {
-            return false;
-        }
-    }
-    return true;
-}
-
-// Função para alternar entre os jogadores após uma jogada.
-void switchPlayer(Game* game) {
-    game->currentPlayer = (game->currentPlayer == PLAYER1) ? PLAYER2 : PLAYER1;
-}
-
-// Função para realizar a jogada em uma coluna e verificar o estado do jogo após o movimento.
-void playMove(Game* game, int col) {
-    if (dropPiece(game, col)) {
-        Player winner = checkVictory(game);
-        if (winner != NONE) {
-            game->winner = winner;
-            game->gameOver = true;
-        } else if (boardFull(game)) {
-            game->gameOver = true;
-        } else {
-            switchPlayer(game);
-        }
-    }
-}
-
-// Função para a jogada do computador, incluindo estratégias de bloqueio e movimentos prioritários.
-int computerMove(Game* game) {
-    // 1. Verifica se o computador pode vencer na próxima jogada
-    int winningMove = findWinningMove(game, PLAYER2);
-    if (winningMove != -1) {
-        return winningMove;  // Jogada de vitória encontrada
-    }
-
-    // 2. Verifica se o jogador pode vencer na próxima jogada e bloqueia
-    int blockingMove = findWinningMove(game, PLAYER1);
-    if (blockingMove != -1) {
-        return blockingMove;  // Bloquear a jogada de vitória do jogador
-    }
-
-    // 3. Prioriza a coluna central para controle estratégico
-    int centerColumn = COLS / 2;
-    if (game->board[0][centerColumn] == NONE) {
-        return centerColumn;
+// Função para acrescentar a partida atual ao registro (sem efeito se o registro não pôde ser aberto).
+void logGame(GameLogWriter* log, const Game* game, bool abandoned, const Engine* engine, const SearchLimits* limits) {
+    if (!log) {
+        return;
     }
-
-    // 4. Procura colunas adjacentes ao centro para expandir o controle
-    for (int offset = 1; offset <= COLS / 2; ++offset) {
-        if (centerColumn - offset >= 0 && game->board[0][centerColumn - offset] == NONE) {
-            return centerColumn - offset;
-        }
-        if (centerColumn + offset < COLS && game->board[0][centerColumn + offset] == NONE) {
-            return centerColumn + offset;
-        }
-    }
-
-    // 5. Verifica colunas laterais como último recurso
-    for (int col = 0; col < COLS; ++col) {
-        if (game->board[0][col] == NONE) {
-            return col;
-        }
-    }
-
-    return -1;  // Nenhuma coluna disponível
-}
-
-int findWinningMove(Game* game, Player player) {
-    for (int col = 0; col < COLS; ++col) {
-        // Simula colocar uma peça nesta coluna para verificar se cria uma vitória
-        if (game->board[0][col] == NONE) {
-            int row;
-            for (row = ROWS - 1; row >= 0; --row) {
-                if (game->board[row][col] == NONE) {
-                    break;
-                }
-            }
-            // Coloca a peça temporariamente
-            game->board[row][col] = player;
-            if (checkVictory(game) == player) {
-                game->board[row][col] = NONE;  // Remove a peça temporária
-                return col;  // Retorna a coluna vencedora ou de bloqueio
-            }
-            game->board[row][col] = NONE;  // Remove a peça temporária
-        }
+    GameRecord record = {
+        .cols = game->variant->cols,
+        .rows = game->variant->rows,
+        .moveCount = game->historyLength,
+        .outcome = abandoned ? OUTCOME_ABANDONED
+                 : game->winner == PLAYER1 ? OUTCOME_PLAYER1
+                 : game->winner == PLAYER2 ? OUTCOME_PLAYER2
+                 : OUTCOME_DRAW,
+        .vsComputer = game->vsComputer,
+        .usedBook = game->vsComputer && engine->book != nullptr,
+        .aiThreads = game->vsComputer ? limits->threads : 0,
+        .aiTimeLimitMs = game->vsComputer ? limits->timeLimitMs : 0,
+        .startTime = (uint64_t)game->startTime,
+        .durationSeconds = (uint32_t)difftime(time(nullptr), game->startTime),
+    };
+    memcpy(record.moves, game->history, (size_t)game->historyLength);
+    if (!gameLogWrite(log, &record)) {
+        printf("Erro ao gravar a partida em %s\n", GAME_LOG_PATH);
     }
-    return -1;  // Nenhuma jogada de vitória ou bloqueio encontrada
 }
 
-void drawButton(SDL_Renderer* renderer, TTF_Font* font, SDL_Rect buttonRect, const char* buttonText) {
-    // Configura as cores do botão
-    SDL_Color borderColor = {200, 200, 200, 255};    // Cinza claro para a borda
-    SDL_Color fillColor = {100, 149, 237, 255};      // Azul claro para o fundo do botão
-    SDL_Color textColor = {255, 255, 255, 255};      // Branco para o texto
-
-    // Desenha o fundo do botão
-    SDL_SetRenderDrawColor(renderer, fillColor.r, fillColor.g, fillColor.b, fillColor.a);
-    SDL_RenderFillRect(renderer, &buttonRect);
-
-    // Desenha a borda do botão
-    SDL_SetRenderDrawColor(renderer, borderColor.r, borderColor.g, borderColor.b, borderColor.a);
-    SDL_RenderDrawRect(renderer, &buttonRect);
-
-    // Desenha o texto do botão
-    SDL_Surface* textSurface = TTF_RenderText_Solid(font, buttonText, textColor);
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-
-    // Centraliza o texto no botão
-    int textWidth = textSurface->w;
-    int textHeight = textSurface->h;
-    SDL_Rect textRect = {
-        buttonRect.x + (buttonRect.w - textWidth) / 2,
-        buttonRect.y + (buttonRect.h - textHeight) / 2,
-        textWidth,
-        textHeight
-    };
-
-    SDL_FreeSurface(textSurface);
-
-    // Renderiza o texto
-    SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-    SDL_DestroyTexture(textTexture);
-}
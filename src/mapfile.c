@@ -0,0 +1,67 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L  // posix_madvise
+#endif
+#include "mapfile.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+void* mapFile(const char* path, size_t* size) {
+#ifdef _WIN32
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return nullptr;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    void* data = length > 0 ? malloc((size_t)length) : nullptr;
+    if (data && fread(data, 1, (size_t)length, file) != (size_t)length) {
+        free(data);
+        data = nullptr;
+    }
+    fclose(file);
+    *size = data ? (size_t)length : 0;
+    return data;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    void* data = nullptr;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            data = nullptr;
+        }
+    }
+    close(fd);
+    *size = data ? (size_t)st.st_size : 0;
+    return data;
+#endif
+}
+
+void unmapFile(void* data, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    free(data);
+#else
+    munmap(data, size);
+#endif
+}
+
+void mapFileSequential(void* data, size_t size) {
+#ifdef _WIN32
+    (void)data;
+    (void)size;
+#else
+    posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+#endif
+}
@@ -0,0 +1,13 @@
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <stddef.h>
+
+// Função para carregar um arquivo inteiro somente para leitura: mapeado na memória em sistemas POSIX,
+// lido no Windows. Devolve nullptr se o arquivo não existe ou está vazio.
+void* mapFile(const char* path, size_t* size);
+void unmapFile(void* data, size_t size);
+// Função para avisar o sistema de que um arquivo mapeado será lido do início ao fim (leitura antecipada).
+void mapFileSequential(void* data, size_t size);
+
+#endif
@@ -0,0 +1,312 @@
+#include "mcts.h"
+#include <math.h>
+#include <stdlib.h>
+#include <threads.h>
+#include "clock.h"
+#include "random.h"
+
+#define EXPLORATION 1.4f        // Peso da exploração na fórmula UCT (resultados entre 0 e 1)
+#define EXPAND_VISITS 2         // Visitas de uma folha antes de ela ganhar filhos
+#define CLOCK_CHECK_INTERVAL 64 // Iterações entre consultas ao relógio
+#define MAX_VISITS (UINT32_MAX / 2) // Teto de visitas da raiz, para os contadores de 32 bits não darem a volta
+
+enum {
+    OUTCOME_OPEN,
+    OUTCOME_WIN,                // Quem jogou até o nó venceu com essa jogada
+    OUTCOME_DRAW                // A jogada encheu o tabuleiro
+};
+
+struct MctsNode {
+    _Atomic uint32_t visits;      // Visitas, contando as descidas ainda em andamento (perda virtual)
+    _Atomic uint32_t reward;      // Resultados para quem jogou até o nó, em meios pontos (vitória 2, empate 1)
+    _Atomic uint32_t firstChild;  // Índice do primeiro filho na arena (0 = sem filhos ainda)
+    atomic_bool expanding;        // Uma thread já está criando os filhos
+    uint8_t childCount;
+    int8_t col;                   // Coluna jogada para chegar ao nó
+    uint8_t outcome;
+};
+
+// Estado de uma thread da busca.
+typedef struct {
+    Mcts* tree;
+    const Position* root;
+    atomic_bool* stop;           // Sinal de parada compartilhado entre as threads
+    uint64_t rng;                // Estado do xorshift64* desta thread
+    uint64_t playouts;
+    int maxDepth;                // Maior profundidade alcançada dentro da árvore
+} MctsWorker;
+
+// i-ésima coluna na ordem de preferência: do centro para as bordas.
+static inline int columnAt(int i) {
+    return COLS / 2 + (i % 2 == 0 ? i / 2 : -(i + 1) / 2);
+}
+
+static void nodeInit(MctsNode* node, int col, int outcome) {
+    atomic_init(&node->visits, 0);
+    atomic_init(&node->reward, 0);
+    atomic_init(&node->firstChild, 0);
+    atomic_init(&node->expanding, false);
+    node->childCount = 0;
+    node->col = (int8_t)col;
+    node->outcome = (uint8_t)outcome;
+}
+
+bool mctsInit(Mcts* tree, size_t megabytes) {
+    *tree = (Mcts){0};
+    size_t capacity = megabytes * 1024 * 1024 / sizeof(MctsNode);
+    if (capacity > UINT32_MAX / 2) {
+        capacity = UINT32_MAX / 2;
+    }
+    if (capacity < COLS + 1) {
+        return false;
+    }
+    tree->nodes = malloc(capacity * sizeof(MctsNode));
+    if (!tree->nodes) {
+        return false;
+    }
+    tree->capacity = (uint32_t)capacity;
+    return true;
+}
+
+void mctsFree(Mcts* tree) {
+    free(tree->nodes);
+    *tree = (Mcts){0};
+}
+
+// Função para criar os filhos de uma folha, do centro para as bordas. Devolve o índice do primeiro, ou 0
+// se outra thread já está expandindo a folha ou se a arena acabou.
+static uint32_t expand(Mcts* tree, MctsNode* node, const Position* pos) {
+    bool expected = false;
+    if (atomic_load_explicit(&tree->full, memory_order_relaxed) ||
+        !atomic_compare_exchange_strong(&node->expanding, &expected, true)) {
+        return 0;
+    }
+    int cols[COLS];
+    int count = 0;
+    for (int i = 0; i < COLS; ++i) {
+        if (positionCanPlay(pos, columnAt(i))) {
+            cols[count++] = columnAt(i);
+        }
+    }
+    uint32_t first = atomic_fetch_add_explicit(&tree->used, (uint32_t)count, memory_order_relaxed);
+    if (first + (uint32_t)count > tree->capacity) {
+        atomic_store(&tree->full, true);
+        atomic_store(&node->expanding, false);
+        return 0;
+    }
+
+    Player player = positionPlayerToMove(pos);
+    bool fills = pos->moves + 1 == ROWS * COLS;
+    for (int i = 0; i < count; ++i) {
+        int outcome = positionWinsWith(pos, cols[i], player) ? OUTCOME_WIN : fills ? OUTCOME_DRAW : OUTCOME_OPEN;
+        nodeInit(&tree->nodes[first + i], cols[i], outcome);
+    }
+    node->childCount = (uint8_t)count;
+    // Os filhos ficam visíveis para as outras threads só depois de inicializados
+    atomic_store_explicit(&node->firstChild, first, memory_order_release);
+    return first;
+}
+
+// Função para escolher o filho com o maior valor UCT; os filhos ainda não visitados vêm primeiro.
+static uint32_t selectChild(const Mcts* tree, const MctsNode* node, uint32_t first) {
+    float logVisits = logf((float)atomic_load_explicit(&node->visits, memory_order_relaxed));
+    uint32_t best = first;
+    float bestValue = -1.0f;
+    for (uint32_t i = first; i < first + node->childCount; ++i) {
+        const MctsNode* child = &tree->nodes[i];
+        uint32_t visits = atomic_load_explicit(&child->visits, memory_order_relaxed);
+        if (visits == 0) {
+            return i;
+        }
+        float reward = (float)atomic_load_explicit(&child->reward, memory_order_relaxed);
+        float value = reward / (2.0f * (float)visits) + EXPLORATION * sqrtf(logVisits / (float)visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = i;
+        }
+    }
+    return best;
+}
+
+// Função para terminar a partida com jogadas aleatórias e devolver o vencedor (NONE no empate). A
+// jogada só não é aleatória quando há uma vitória imediata (joga nela) ou uma ameaça do adversário
+// (bloqueia): assim os playouts não desperdiçam partidas decididas na jogada seguinte.
+static Player playout(Position pos, uint64_t* rng) {
+    while (!positionIsFull(&pos)) {
+        Player player = positionPlayerToMove(&pos);
+        Player opponent = otherPlayer(player);
+        int moves[COLS];
+        int count = 0;
+        int block = -1;
+        for (int col = 0; col < COLS; ++col) {
+            if (!positionCanPlay(&pos, col)) {
+                continue;
+            }
+            if (positionWinsWith(&pos, col, player)) {
+                return player;
+            }
+            if (positionWinsWith(&pos, col, opponent)) {
+                block = col;
+            }
+            moves[count++] = col;
+        }
+        int col = block >= 0 ? block : moves[((nextRandom(rng) >> 32) * (uint64_t)count) >> 32];
+        positionPlay(&pos, col);
+    }
+    return NONE;
+}
+
+// Função para uma iteração: descida com perda virtual, expansão, playout e atualização do caminho.
+static void iterate(MctsWorker* worker) {
+    Mcts* tree = worker->tree;
+    Position pos = *worker->root;
+    uint32_t path[ROWS * COLS + 1];
+    int length = 0;
+
+    uint32_t index = 0;
+    atomic_fetch_add_explicit(&tree->nodes[0].visits, 1, memory_order_relaxed);
+    path[length++] = 0;
+    Player winner;
+    for (;;) {
+        MctsNode* node = &tree->nodes[index];
+        if (node->outcome != OUTCOME_OPEN) {
+            winner = node->outcome == OUTCOME_WIN ? otherPlayer(positionPlayerToMove(&pos)) : NONE;
+            break;
+        }
+        uint32_t first = atomic_load_explicit(&node->firstChild, memory_order_acquire);
+        if (first == 0) {
+            if (atomic_load_explicit(&node->visits, memory_order_relaxed) >= EXPAND_VISITS) {
+                first = expand(tree, node, &pos);
+            }
+            if (first == 0) {
+                winner = playout(pos, &worker->rng);
+                break;
+            }
+        }
+        index = selectChild(tree, node, first);
+        positionPlay(&pos, tree->nodes[index].col);
+        atomic_fetch_add_explicit(&tree->nodes[index].visits, 1, memory_order_relaxed);
+        path[length++] = index;
+    }
+
+    // A visita já foi contada na descida; falta só a recompensa de quem jogou até cada nó
+    for (int i = length - 1; i >= 1; --i) {
+        Player mover = (worker->root->moves + i - 1) % 2 == 0 ? PLAYER1 : PLAYER2;
+        uint32_t reward = winner == mover ? 2 : winner == NONE ? 1 : 0;
+        if (reward) {
+            atomic_fetch_add_explicit(&tree->nodes[path[i]].reward, reward, memory_order_relaxed);
+        }
+    }
+    if (length - 1 > worker->maxDepth) {
+        worker->maxDepth = length - 1;
+    }
+    worker->playouts++;
+}
+
+// Laço de uma thread auxiliar: itera até receber o sinal de parada.
+static int helperMain(void* arg) {
+    MctsWorker* worker = arg;
+    while (!atomic_load_explicit(worker->stop, memory_order_relaxed)) {
+        iterate(worker);
+    }
+    return 0;
+}
+
+SearchResult mctsBestMove(Mcts* tree, const Position* pos, const SearchLimits* limits) {
+    uint64_t start = clockNowUs();
+    SearchResult result = {.bestCol = -1};
+    if (positionIsFull(pos)) {
+        return result;
+    }
+
+    // Árvore nova: a raiz e seus filhos são criados antes de as threads começarem
+    nodeInit(&tree->nodes[0], -1, OUTCOME_OPEN);
+    atomic_store(&tree->used, 1);
+    atomic_store(&tree->full, false);
+    uint32_t first = expand(tree, &tree->nodes[0], pos);
+    for (uint32_t i = first; i < first + tree->nodes[0].childCount; ++i) {
+        if (tree->nodes[i].outcome == OUTCOME_WIN) {
+            result.bestCol = tree->nodes[i].col;
+            result.score = SCORE_WIN - (pos->moves + 1);
+            result.depth = 1;
+            result.solved = true;
+            result.elapsedUs = clockNowUs() - start;
+            return result;
+        }
+    }
+
+    uint64_t deadlineUs = limits->timeLimitMs ? start + (uint64_t)limits->timeLimitMs * 1000u : 0;
+    // Sem limite de tempo nem de playouts, a busca para quando a arena enche. Perto do fim da partida todos os
+    // caminhos podem acabar em nós decididos sem que ela encha: por isso os playouts ficam limitados também
+    // ao número de nós da arena.
+    uint64_t playoutLimit = limits->nodeLimit ? limits->nodeLimit : deadlineUs ? MAX_VISITS : tree->capacity;
+    if (playoutLimit > MAX_VISITS) {
+        playoutLimit = MAX_VISITS;
+    }
+    atomic_bool stop = false;
+    MctsWorker caller = {.tree = tree, .root = pos, .stop = &stop, .rng = start | 1};
+
+    int helperCount = limits->threads > 1 ? limits->threads - 1 : 0;
+    if (helperCount > SEARCH_MAX_THREADS - 1) {
+        helperCount = SEARCH_MAX_THREADS - 1;
+    }
+    MctsWorker helpers[SEARCH_MAX_THREADS - 1];
+    thrd_t threads[SEARCH_MAX_THREADS - 1];
+    int started = 0;
+    for (; started < helperCount; ++started) {
+        helpers[started] = (MctsWorker){
+            .tree = tree, .root = pos, .stop = &stop,
+            .rng = (start + (uint64_t)(started + 1) * 0x9E3779B97F4A7C15u) | 1,
+        };
+        if (thrd_create(&threads[started], helperMain, &helpers[started]) != thrd_success) {
+            break;
+        }
+    }
+
+    // A thread que chamou também itera e decide quando parar
+    for (;;) {
+        iterate(&caller);
+        if (atomic_load_explicit(&tree->nodes[0].visits, memory_order_relaxed) >= playoutLimit) {
+            break;
+        }
+        if (!deadlineUs && !limits->nodeLimit && atomic_load_explicit(&tree->full, memory_order_relaxed)) {
+            break;
+        }
+        if (caller.playouts % CLOCK_CHECK_INTERVAL == 0) {
+            if (deadlineUs && clockNowUs() >= deadlineUs) {
+                break;
+            }
+            if (limits->cancel && atomic_load_explicit(limits->cancel, memory_order_relaxed)) {
+                result.cancelled = true;
+                break;
+            }
+        }
+    }
+    atomic_store(&stop, true);
+
+    result.playouts = caller.playouts;
+    result.depth = caller.maxDepth;
+    for (int i = 0; i < started; ++i) {
+        thrd_join(threads[i], nullptr);
+        result.playouts += helpers[i].playouts;
+        if (helpers[i].maxDepth > result.depth) {
+            result.depth = helpers[i].maxDepth;
+        }
+    }
+
+    // A jogada é a do filho mais visitado, o critério mais estável contra a variação dos playouts
+    uint32_t bestVisits = 0;
+    for (uint32_t i = first; i < first + tree->nodes[0].childCount; ++i) {
+        uint32_t visits = atomic_load(&tree->nodes[i].visits);
+        if (result.bestCol < 0 || visits > bestVisits) {
+            bestVisits = visits;
+            result.bestCol = tree->nodes[i].col;
+            float rate = bestVisits ? (float)atomic_load(&tree->nodes[i].reward) / (2.0f * (float)bestVisits) : 0.5f;
+            result.score = (int)((2.0f * rate - 1.0f) * SCORE_DECISIVE);
+        }
+    }
+    uint32_t used = atomic_load(&tree->used);
+    result.nodes = used < tree->capacity ? used : tree->capacity;
+    result.elapsedUs = clockNowUs() - start;
+    return result;
+}
@@ -0,0 +1,39 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "position.h"
+#include "search.h"
+
+// Motor alternativo à busca alfa-beta, para um modo de jogo mais "humano" e limitado por tempo: busca em
+// árvore Monte Carlo com UCT. Cada iteração desce a árvore escolhendo os filhos pela fórmula UCT, cria os
+// filhos da folha e termina a partida com jogadas aleatórias sobre o bitboard (playout); o resultado sobe
+// pelo caminho. As threads compartilham a mesma árvore: cada descida soma aos nós do caminho uma visita
+// sem recompensa (perda virtual), que afasta as outras threads do ramo até o resultado chegar.
+// Os nós vêm de uma arena alocada uma vez em mctsInit; a busca não faz nenhuma alocação.
+
+typedef struct MctsNode MctsNode;
+
+typedef struct {
+    MctsNode* nodes;       // nodes[0] é a raiz da busca em andamento
+    uint32_t capacity;
+    _Atomic uint32_t used;
+    atomic_bool full;      // A arena acabou: as folhas deixam de ser expandidas, mas os playouts continuam
+} Mcts;
+
+// Função para alocar a arena de nós com até megabytes de memória.
+bool mctsInit(Mcts* tree, size_t megabytes);
+void mctsFree(Mcts* tree);
+
+// Função para escolher uma jogada com MCTS. Cada busca começa uma árvore nova. Dos limites valem
+// timeLimitMs, nodeLimit (aqui, o total de playouts de todas as threads), threads e cancel; sem limite de
+// tempo nem de playouts, a busca para quando a arena enche ou quando o número de playouts chega ao de nós da
+// arena (o que acontece antes perto do fim da partida, quando a árvore se esgota em posições decididas).
+// Em qualquer caso, a busca para antes de 2^31 playouts, para os contadores de 32 bits não darem a volta.
+// A coluna escolhida é a mais visitada; a pontuação é a taxa de vitória estimada, levada à faixa não decisiva da escala do motor (de
+// -SCORE_DECISIVE a SCORE_DECISIVE), e só uma vitória imediata vem como pontuação exata.
+SearchResult mctsBestMove(Mcts* tree, const Position* pos, const SearchLimits* limits);
+
+#endif
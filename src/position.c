@@ -0,0 +1,13 @@
+#include "position.h"
+
+int positionFromMoves(Position* pos, const char* moves) {
+    positionInit(pos);
+    for (const char* c = moves; *c; ++c) {
+        int col = *c - '1';
+        if (col < 0 || col >= COLS || !positionCanPlay(pos, col) || positionWinsWith(pos, col, positionPlayerToMove(pos))) {
+            return -1;
+        }
+        positionPlay(pos, col);
+    }
+    return pos->moves;
+}
@@ -0,0 +1,242 @@
+#ifndef POSITION_H
+#define POSITION_H
+
+#include <stdint.h>
+#include "boardsize.h"
+
+// Cada coluna ocupa ROWS + 1 bits no bitboard (de baixo para cima); o bit extra no topo de cada
+// coluna fica sempre vazio e separa uma coluna da próxima.
+#define COL_BITS (ROWS + 1)
+#define BOARD_BITS (COL_BITS * COLS)
+
+typedef enum {
+    NONE = 0,
+    PLAYER1,
+    PLAYER2
+} Player;
+
+// Tabuleiros de até 64 bits (como o padrão e o 8x7) usam uma palavra de 64 bits; os maiores, 128 bits.
+#if BOARD_BITS <= 64
+typedef uint64_t Bitboard;
+#else
+typedef unsigned __int128 Bitboard;
+#endif
+
+// Posição do tabuleiro em bitboard: cabe inteira em uma linha de cache.
+typedef struct {
+    Bitboard current;        // Peças do jogador da vez
+    Bitboard mask;           // Todas as casas ocupadas
+    uint8_t height[COLS];    // Quantidade de peças em cada coluna
+    uint8_t moves;           // Jogadas realizadas desde o início
+} Position;
+
+// Bit da casa mais baixa de uma coluna.
+static inline Bitboard bottomBit(int col) {
+    return (Bitboard)1 << (col * COL_BITS);
+}
+
+// Bit de uma casa; a linha é contada a partir do topo, como na tela.
+static inline Bitboard cellBit(int row, int col) {
+    return bottomBit(col) << (ROWS - 1 - row);
+}
+
+// Função para inicializar uma posição vazia.
+static inline void positionInit(Position* pos) {
+    *pos = (Position){0};
+}
+
+// Adversário de um jogador.
+static inline Player otherPlayer(Player player) {
+    return player == PLAYER1 ? PLAYER2 : PLAYER1;
+}
+
+// Jogador que faz a próxima jogada (o jogador 1 sempre começa).
+static inline Player positionPlayerToMove(const Position* pos) {
+    return (pos->moves & 1) ? PLAYER2 : PLAYER1;
+}
+
+// Função para verificar se ainda há espaço em uma coluna.
+static inline bool positionCanPlay(const Position* pos, int col) {
+    return col >= 0 && col < COLS && pos->height[col] < ROWS;
+}
+
+// Bit da casa onde a próxima peça jogada em uma coluna vai parar.
+static inline Bitboard positionMoveBit(const Position* pos, int col) {
+    return bottomBit(col) << pos->height[col];
+}
+
+// Linha (contada a partir do topo) onde a próxima peça de uma coluna vai parar.
+static inline int positionLandingRow(const Position* pos, int col) {
+    return ROWS - 1 - pos->height[col];
+}
+
+// Função para jogar uma peça do jogador da vez em uma coluna jogável e passar a vez.
+static inline void positionPlay(Position* pos, int col) {
+    pos->current ^= pos->mask;
+    pos->mask |= positionMoveBit(pos, col);
+    pos->height[col]++;
+    pos->moves++;
+}
+
+// Função para verificar se todas as casas estão ocupadas.
+static inline bool positionIsFull(const Position* pos) {
+    return pos->moves == ROWS * COLS;
+}
+
+// Peças de um jogador específico.
+static inline Bitboard positionStones(const Position* pos, Player player) {
+    return player == positionPlayerToMove(pos) ? pos->current : pos->current ^ pos->mask;
+}
+
+// Chave de 64 bits de um par (peças do jogador da vez, casas ocupadas). Em tabuleiros de até 64 bits é a
+// soma dos dois, única para cada posição e menor que 2^BOARD_BITS (o bit mais alto é sempre um sentinela
+// vazio); nos maiores as duas metades da soma são misturadas, e posições diferentes podem ter a mesma chave.
+static inline uint64_t bitboardKey(Bitboard current, Bitboard mask) {
+#if BOARD_BITS <= 64
+    return current + mask;
+#else
+    Bitboard key = current + mask;
+    return (uint64_t)key ^ (uint64_t)(key >> 64) * 0x9E3779B97F4A7C15u;
+#endif
+}
+
+// Bits significativos da chave e se ela identifica a posição sem ambiguidade.
+#if BOARD_BITS <= 64
+#define POSITION_KEY_BITS BOARD_BITS
+#define POSITION_KEY_UNIQUE true
+#else
+#define POSITION_KEY_BITS 64
+#define POSITION_KEY_UNIQUE false
+#endif
+
+// Chave da posição, usada pela tabela de transposição e pelo livro de aberturas.
+static inline uint64_t positionKey(const Position* pos) {
+    return bitboardKey(pos->current, pos->mask);
+}
+
+// Dono de uma casa; a linha é contada a partir do topo, como na tela.
+static inline Player positionCellOwner(const Position* pos, int row, int col) {
+    Bitboard bit = cellBit(row, col);
+    if (!(pos->mask & bit)) {
+        return NONE;
+    }
+    Player toMove = positionPlayerToMove(pos);
+    return (pos->current & bit) ? toMove : otherPlayer(toMove);
+}
+
+// Deslocamentos entre casas vizinhas no bitboard para cada direção de alinhamento.
+#define SHIFT_VERTICAL 1
+#define SHIFT_HORIZONTAL COL_BITS
+#define SHIFT_DIAGONAL_UP (COL_BITS + 1)
+#define SHIFT_DIAGONAL_DOWN (COL_BITS - 1)
+
+// Bits onde começa uma sequência de quatro peças na direção dada (o bit de sentinela impede
+// que uma sequência atravesse de uma coluna para a próxima).
+static inline Bitboard bitboardFourStarts(Bitboard stones, int shift) {
+    Bitboard pairs = stones & (stones >> shift);
+    return pairs & (pairs >> (2 * shift));
+}
+
+// Função para verificar, sem laços, se um conjunto de peças contém quatro em linha.
+static inline bool bitboardHasFour(Bitboard stones) {
+    return (bitboardFourStarts(stones, SHIFT_VERTICAL) |
+            bitboardFourStarts(stones, SHIFT_HORIZONTAL) |
+            bitboardFourStarts(stones, SHIFT_DIAGONAL_UP) |
+            bitboardFourStarts(stones, SHIFT_DIAGONAL_DOWN)) != 0;
+}
+
+// Função para verificar se um jogador venceria jogando em uma coluna jogável.
+static inline bool positionWinsWith(const Position* pos, int col, Player player) {
+    return bitboardHasFour(positionStones(pos, player) | positionMoveBit(pos, col));
+}
+
+// Função para verificar se a última peça jogada completou quatro em linha.
+static inline bool positionLastMoveWon(const Position* pos) {
+    return bitboardHasFour(pos->current ^ pos->mask);
+}
+
+// Índice do bit menos significativo de um bitboard não vazio.
+static inline int bitboardLowestBit(Bitboard board) {
+#if BOARD_BITS <= 64
+    return __builtin_ctzll(board);
+#else
+    uint64_t low = (uint64_t)board;
+    return low ? __builtin_ctzll(low) : 64 + __builtin_ctzll((uint64_t)(board >> 64));
+#endif
+}
+
+// Quantidade de bits ligados em um bitboard.
+static inline int bitboardCount(Bitboard board) {
+#if BOARD_BITS <= 64
+    return __builtin_popcountll(board);
+#else
+    return __builtin_popcountll((uint64_t)board) + __builtin_popcountll((uint64_t)(board >> 64));
+#endif
+}
+
+// Casas da linha de baixo de todas as colunas.
+static inline Bitboard bitboardBottomRow(void) {
+    Bitboard row = 0;
+    for (int col = 0; col < COLS; ++col) {
+        row |= bottomBit(col);
+    }
+    return row;
+}
+
+// Todas as casas do tabuleiro, sem os bits de sentinela.
+static inline Bitboard bitboardCells(void) {
+    return bitboardBottomRow() * (((Bitboard)1 << ROWS) - 1);
+}
+
+// Casas das linhas ímpares, contadas de baixo a partir de 1 (onde as ameaças favorecem o jogador 1).
+static inline Bitboard bitboardOddRows(void) {
+    return bitboardBottomRow() * (0x55u & ((1u << ROWS) - 1));
+}
+
+// Casas que completariam quatro em linha ao longo de uma direção horizontal ou diagonal.
+static inline Bitboard bitboardWinningCellsAlong(Bitboard stones, int shift) {
+    Bitboard before = (stones << shift) & (stones << 2 * shift);  // Duas peças antes da casa
+    Bitboard after = (stones >> shift) & (stones >> 2 * shift);   // Duas peças depois da casa
+    return (before & ((stones << 3 * shift) | (stones >> shift))) |  // XXX_ e XX_X
+           (after & ((stones << shift) | (stones >> 3 * shift)));    // X_XX e _XXX
+}
+
+// Casas vazias que completariam quatro em linha para as peças dadas, em todas as direções de uma vez.
+// Inclui casas que ainda não podem ser jogadas (ameaças à espera de a coluna subir).
+static inline Bitboard bitboardWinningCells(Bitboard stones, Bitboard occupied) {
+    Bitboard cells = (stones << 1) & (stones << 2) & (stones << 3);  // Vertical: só acima de três peças
+    cells |= bitboardWinningCellsAlong(stones, SHIFT_HORIZONTAL);
+    cells |= bitboardWinningCellsAlong(stones, SHIFT_DIAGONAL_UP);
+    cells |= bitboardWinningCellsAlong(stones, SHIFT_DIAGONAL_DOWN);
+    return cells & (bitboardCells() ^ occupied);
+}
+
+// Casas onde a próxima peça de cada coluna não cheia vai parar.
+static inline Bitboard positionPlayableCells(const Position* pos) {
+    return (pos->mask + bitboardBottomRow()) & bitboardCells();
+}
+
+// Função para localizar uma sequência de quatro em linha, gravando a coluna e a linha (a partir do topo)
+// de cada peça. Só deve ser chamada quando a vitória já foi detectada.
+static inline bool bitboardFindFour(Bitboard stones, int cols[4], int rows[4]) {
+    static const int shifts[4] = {SHIFT_VERTICAL, SHIFT_HORIZONTAL, SHIFT_DIAGONAL_UP, SHIFT_DIAGONAL_DOWN};
+    for (int d = 0; d < 4; ++d) {
+        Bitboard starts = bitboardFourStarts(stones, shifts[d]);
+        if (starts) {
+            int bit = bitboardLowestBit(starts);
+            for (int i = 0; i < 4; ++i) {
+                int cell = bit + i * shifts[d];
+                cols[i] = cell / COL_BITS;
+                rows[i] = ROWS - 1 - cell % COL_BITS;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// Função para montar uma posição a partir de uma sequência de colunas ("4453..."; a coluna 1 é a da
+// esquerda). Devolve o número de jogadas, ou -1 se a sequência for inválida ou passar por uma vitória.
+int positionFromMoves(Position* pos, const char* moves);
+
+#endif
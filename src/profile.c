@@ -0,0 +1,230 @@
+#include "profile.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <threads.h>
+#include "clock.h"
+
+typedef struct {
+    const char* name;
+    uint64_t timestampUs;  // Relativo ao início da gravação
+    uint64_t durationUs;
+    double value;
+    uint32_t thread;
+    char phase;            // 'X' = intervalo, 'C' = contador (como no formato trace_event)
+    atomic_bool ready;     // O evento foi escrito por completo
+} TraceEvent;
+
+// Buffer de eventos: cada thread reserva uma posição com um incremento atômico e a preenche sem travas.
+static TraceEvent* events;
+static atomic_size_t eventCount;
+static atomic_bool recording;
+static atomic_uint writers;  // Threads que reservaram uma posição e ainda a estão preenchendo
+static uint64_t originUs;
+
+// Cada thread recebe um número na primeira vez que registra um evento.
+static atomic_uint threadCount;
+static thread_local uint32_t threadId;
+
+// Tempos dos últimos quadros (só a thread da interface os usa).
+static uint64_t frameTimes[PROFILE_FRAME_HISTORY];
+static int frameCount;
+static int frameNext;
+
+// Números da última busca, escritos pela thread da IA e lidos pela interface.
+static once_flag statsOnce = ONCE_FLAG_INIT;
+static mtx_t statsLock;
+static SearchStats lastSearch;
+
+static uint32_t currentThread(void) {
+    if (threadId == 0) {
+        threadId = atomic_fetch_add(&threadCount, 1) + 1;
+    }
+    return threadId;
+}
+
+// Função para reservar a próxima posição do buffer; devolve nullptr se a gravação está desligada ou cheia.
+// Quem recebe uma posição conta como escritor até chamar finishEvent.
+static TraceEvent* reserveEvent(void) {
+    if (!atomic_load_explicit(&recording, memory_order_relaxed)) {
+        return nullptr;
+    }
+    // O escritor se registra antes de confirmar a gravação: profileStartRecording espera os registrados
+    atomic_fetch_add(&writers, 1);
+    if (atomic_load(&recording)) {
+        size_t index = atomic_fetch_add_explicit(&eventCount, 1, memory_order_relaxed);
+        if (index < PROFILE_MAX_EVENTS) {
+            return &events[index];
+        }
+    }
+    atomic_fetch_sub_explicit(&writers, 1, memory_order_release);
+    return nullptr;
+}
+
+static void finishEvent(TraceEvent* event) {
+    atomic_store_explicit(&event->ready, true, memory_order_release);
+    atomic_fetch_sub_explicit(&writers, 1, memory_order_release);
+}
+
+bool profileStartRecording(void) {
+    if (atomic_load(&recording)) {
+        return true;
+    }
+    if (!events) {
+        events = calloc(PROFILE_MAX_EVENTS, sizeof(TraceEvent));
+        if (!events) {
+            return false;
+        }
+    }
+    // Uma thread da gravação anterior pode ainda estar preenchendo a posição que reservou; limpar o buffer
+    // antes de ela terminar poria o evento antigo, marcado como pronto, no novo trace
+    while (atomic_load_explicit(&writers, memory_order_acquire) != 0) {
+        thrd_yield();
+    }
+    for (size_t i = 0; i < PROFILE_MAX_EVENTS; ++i) {
+        atomic_store_explicit(&events[i].ready, false, memory_order_relaxed);
+    }
+    atomic_store(&eventCount, 0);
+    originUs = clockNowUs();
+    atomic_store_explicit(&recording, true, memory_order_release);
+    return true;
+}
+
+void profileStopRecording(void) {
+    atomic_store(&recording, false);
+}
+
+bool profileRecording(void) {
+    return atomic_load_explicit(&recording, memory_order_relaxed);
+}
+
+size_t profileEventCount(void) {
+    size_t count = atomic_load(&eventCount);
+    return count < PROFILE_MAX_EVENTS ? count : PROFILE_MAX_EVENTS;
+}
+
+uint64_t profileBegin(void) {
+    return clockNowUs();
+}
+
+uint64_t profileEnd(const char* name, uint64_t startUs) {
+    uint64_t endUs = clockNowUs();
+    TraceEvent* event = reserveEvent();
+    if (event) {
+        event->name = name;
+        event->timestampUs = startUs > originUs ? startUs - originUs : 0;
+        event->durationUs = endUs - startUs;
+        event->thread = currentThread();
+        event->phase = 'X';
+        finishEvent(event);
+    }
+    return endUs - startUs;
+}
+
+void profileCounter(const char* name, double value) {
+    TraceEvent* event = reserveEvent();
+    if (event) {
+        event->name = name;
+        event->timestampUs = clockNowUs() - originUs;
+        event->value = value;
+        event->thread = currentThread();
+        event->phase = 'C';
+        finishEvent(event);
+    }
+}
+
+void profileFrame(uint64_t workUs) {
+    frameTimes[frameNext] = workUs;
+    frameNext = (frameNext + 1) % PROFILE_FRAME_HISTORY;
+    if (frameCount < PROFILE_FRAME_HISTORY) {
+        frameCount++;
+    }
+}
+
+static int compareTimes(const void* a, const void* b) {
+    uint64_t ta = *(const uint64_t*)a;
+    uint64_t tb = *(const uint64_t*)b;
+    return (ta > tb) - (ta < tb);
+}
+
+FrameStats profileFrameStats(void) {
+    FrameStats stats = {.count = frameCount};
+    if (frameCount == 0) {
+        return stats;
+    }
+    uint64_t sorted[PROFILE_FRAME_HISTORY];
+    for (int i = 0; i < frameCount; ++i) {
+        sorted[i] = frameTimes[i];
+    }
+    qsort(sorted, (size_t)frameCount, sizeof(uint64_t), compareTimes);
+    stats.p50 = sorted[(frameCount - 1) * 50 / 100];
+    stats.p95 = sorted[(frameCount - 1) * 95 / 100];
+    stats.p99 = sorted[(frameCount - 1) * 99 / 100];
+    stats.max = sorted[frameCount - 1];
+    return stats;
+}
+
+static void initStatsLock(void) {
+    mtx_init(&statsLock, mtx_plain);
+}
+
+void profileSearch(const SearchResult* result) {
+    SearchStats stats = {
+        .nodes = result->nodes,
+        .elapsedUs = result->elapsedUs,
+        .nodesPerSecond = result->elapsedUs ? result->nodes * 1000000u / result->elapsedUs : 0,
+        .playouts = result->playouts,
+        .playoutsPerSecond = result->elapsedUs ? result->playouts * 1000000u / result->elapsedUs : 0,
+        .ttHitRate = result->tt.probes ? (double)result->tt.hits / (double)result->tt.probes : 0.0,
+        .depth = result->depth,
+        .fromBook = result->fromBook,
+        .fromEndgame = result->fromEndgame,
+    };
+    call_once(&statsOnce, initStatsLock);
+    mtx_lock(&statsLock);
+    stats.searches = lastSearch.searches + 1;
+    lastSearch = stats;
+    mtx_unlock(&statsLock);
+
+    profileCounter("nodes", (double)stats.nodes);
+    profileCounter("nodesPerSecond", (double)stats.nodesPerSecond);
+    if (stats.playouts) {
+        profileCounter("playoutsPerSecond", (double)stats.playoutsPerSecond);
+    }
+    profileCounter("ttHitRate", stats.ttHitRate * 100.0);
+    profileCounter("depth", stats.depth);
+}
+
+SearchStats profileSearchStats(void) {
+    call_once(&statsOnce, initStatsLock);
+    mtx_lock(&statsLock);
+    SearchStats stats = lastSearch;
+    mtx_unlock(&statsLock);
+    return stats;
+}
+
+bool profileWriteTrace(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    size_t count = profileEventCount();
+    bool first = true;
+    for (size_t i = 0; i < count; ++i) {
+        const TraceEvent* event = &events[i];
+        if (!atomic_load_explicit(&event->ready, memory_order_acquire)) {
+            continue;  // Reservado por uma thread que ainda não terminou de escrever
+        }
+        fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":1,\"tid\":%u", first ? "" : ",\n",
+                event->name, event->phase, (unsigned long long)event->timestampUs, event->thread);
+        if (event->phase == 'X') {
+            fprintf(file, ",\"dur\":%llu}", (unsigned long long)event->durationUs);
+        } else {
+            fprintf(file, ",\"args\":{\"value\":%.3f}}", event->value);
+        }
+        first = false;
+    }
+    fprintf(file, "\n]}\n");
+    return fclose(file) == 0;
+}
@@ -0,0 +1,65 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "search.h"
+
+// Instrumentação leve, ligada em tempo de execução. Com a gravação desligada, cada marcação custa uma
+// leitura do relógio e uma leitura atômica. Com ela ligada, os intervalos medidos e os contadores vão para um buffer fixo, que
+// profileWriteTrace grava no formato trace_event do Chrome (abrir em chrome://tracing ou ui.perfetto.dev).
+// Além do trace, o módulo guarda os tempos dos últimos quadros e os números da última busca, que a
+// interface mostra na sobreposição de desempenho (F3).
+
+#define PROFILE_MAX_EVENTS 65536   // Eventos guardados por gravação; os excedentes são descartados
+#define PROFILE_FRAME_HISTORY 240  // Quadros usados no cálculo dos percentis
+
+// Números da última busca do computador.
+typedef struct {
+    uint64_t nodes;
+    uint64_t elapsedUs;
+    uint64_t nodesPerSecond;
+    uint64_t playouts;     // Só no MCTS: partidas simuladas e sua taxa
+    uint64_t playoutsPerSecond;
+    double ttHitRate;      // Fração das consultas à tabela de transposição que encontraram a posição
+    int depth;
+    bool fromBook;
+    bool fromEndgame;
+    uint64_t searches;     // Buscas registradas desde o início do programa
+} SearchStats;
+
+// Percentis do tempo de trabalho por quadro, em microssegundos.
+typedef struct {
+    uint64_t p50;
+    uint64_t p95;
+    uint64_t p99;
+    uint64_t max;
+    int count;             // Quadros considerados (até PROFILE_FRAME_HISTORY)
+} FrameStats;
+
+// Função para começar ou parar a gravação do trace; ao começar, os eventos anteriores são descartados.
+bool profileStartRecording(void);
+void profileStopRecording(void);
+bool profileRecording(void);
+size_t profileEventCount(void);
+
+// Marca o início de um intervalo; o valor devolvido vai para profileEnd.
+uint64_t profileBegin(void);
+// Função para registrar um intervalo iniciado por profileBegin; devolve a duração em microssegundos,
+// mesmo com a gravação desligada. O nome deve ser uma constante.
+uint64_t profileEnd(const char* name, uint64_t startUs);
+// Função para registrar o valor de um contador no trace. O nome deve ser uma constante.
+void profileCounter(const char* name, double value);
+
+// Função para registrar o tempo de trabalho de um quadro e obter os percentis dos últimos quadros.
+void profileFrame(uint64_t workUs);
+FrameStats profileFrameStats(void);
+
+// Função para registrar o resultado de uma busca (pode ser chamada de qualquer thread).
+void profileSearch(const SearchResult* result);
+SearchStats profileSearchStats(void);
+
+// Função para gravar os eventos registrados em um arquivo JSON do Chrome trace_event.
+bool profileWriteTrace(const char* path);
+
+#endif
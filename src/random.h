@@ -0,0 +1,15 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+// Gerador xorshift64*: rápido, sem estado global e reproduzível a partir da semente (que não pode ser 0).
+// Cada usuário guarda o próprio estado, por partida, por conexão ou por thread.
+static inline uint64_t nextRandom(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1Du;
+}
+
+#endif
@@ -0,0 +1,325 @@
+#include "render.h"
+#include <string.h>
+#include "profile.h"
+
+// Função para desenhar a cena atual inteira (a sobreposição de desempenho é desenhada por cima, depois).
+void drawScene(SDL_Renderer* renderer, RenderCache* cache, const Scene* scene, const Game* game, TTF_Font* font,
+               HudTimings* timings) {
+    switch (scene->id) {
+        case SCENE_TITLE:
+            drawPrompt(renderer, cache, font, "Escolha o modo de jogo", "1 jogador", "2 jogadores");
+            break;
+        case SCENE_PLAYING: {
+            uint64_t start = profileBegin();
+            drawBoard(renderer, cache, game);
+            timings->boardUs = profileEnd("drawBoard", start);
+
+            start = profileBegin();
+            displayTurn(renderer, cache, game, font);
+            timings->turnUs = profileEnd("displayTurn", start);
+            break;
+        }
+        case SCENE_GAME_OVER:
+            drawGameOver(renderer, cache, scene, game, font);
+            break;
+        case SCENE_RESTART:
+            drawPrompt(renderer, cache, font, "Deseja jogar novamente?", "Sim", "Não");
+            break;
+    }
+}
+
+// Posição dos dois botões das telas de escolha (0 à esquerda, 1 à direita).
+static SDL_Rect promptButton(const BoardVariant* variant, int index) {
+    int width = WINDOW_WIDTH(variant);
+    int height = WINDOW_HEIGHT(variant);
+    return (SDL_Rect){index == 0 ? width / 2 - 170 : width / 2 + 10, height / 2, 160, 50};
+}
+
+// Função para desenhar uma mensagem com dois botões, usada na escolha do modo e na pergunta de reinício.
+void drawPrompt(SDL_Renderer* renderer, RenderCache* cache, TTF_Font* font, const char* message,
+                const char* firstText, const char* secondText) {
+    SDL_Color textColor = {255, 255, 255, 255};
+    int width = WINDOW_WIDTH(cache->variant);
+    int height = WINDOW_HEIGHT(cache->variant);
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    const TextEntry* entry = cachedText(renderer, cache, font, message, textColor);
+    if (entry) {
+        SDL_Rect messageRect = {width / 2 - entry->width / 2, height / 2 - 80, entry->width, entry->height};
+        SDL_RenderCopy(renderer, entry->texture, nullptr, &messageRect);
+    }
+    drawButton(renderer, cache, font, promptButton(cache->variant, 0), firstText);
+    drawButton(renderer, cache, font, promptButton(cache->variant, 1), secondText);
+}
+
+// Função para descobrir qual botão da tela de escolha está no ponto clicado; devolve -1 se nenhum.
+int promptButtonAt(const BoardVariant* variant, int x, int y) {
+    SDL_Point point = {x, y};
+    for (int i = 0; i < 2; ++i) {
+        SDL_Rect button = promptButton(variant, i);
+        if (SDL_PointInRect(&point, &button)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Função para desenhar a etapa atual da tela final: o tabuleiro parado, o destaque da sequência vencedora
+// com discos brancos e, por fim, o resultado.
+void drawGameOver(SDL_Renderer* renderer, RenderCache* cache, const Scene* scene, const Game* game, TTF_Font* font) {
+    if (scene->stage == GAME_OVER_BOARD || (scene->stage == GAME_OVER_HIGHLIGHT && game->winner == NONE)) {
+        drawBoard(renderer, cache, game);
+        displayTurn(renderer, cache, game, font);
+        return;
+    }
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    if (scene->stage == GAME_OVER_HIGHLIGHT) {
+        for (int i = 0; i < 4; ++i) {
+            int x = game->winningSequence[i].x * TILE_SIZE + TILE_SIZE / 2;
+            int y = game->winningSequence[i].y * TILE_SIZE + TILE_SIZE / 2 + 50;
+            drawDisc(renderer, cache, NONE, x, y);
+        }
+        return;
+    }
+
+    const char* message = game->winner == PLAYER1 ? "Jogador 1 venceu!"
+                        : game->winner == NONE ? "Empate!"
+                        : game->vsComputer ? "Computador venceu!"
+                        : "Jogador 2 venceu!";
+    SDL_Color textColor = {255, 255, 255, 255};
+    const TextEntry* entry = cachedText(renderer, cache, font, message, textColor);
+    if (entry) {
+        int width = WINDOW_WIDTH(game->variant);
+        int height = WINDOW_HEIGHT(game->variant);
+        SDL_Rect textRect = {width / 2 - entry->width / 2, height / 2 + TILE_SIZE, entry->width, entry->height};
+        SDL_RenderCopy(renderer, entry->texture, nullptr, &textRect);
+    }
+}
+
+// Função para exibir de quem é o turno na interface (do jogador ou do computador).
+void displayTurn(SDL_Renderer* renderer, RenderCache* cache, const Game* game, TTF_Font* font) {
+    SDL_Rect messageRect = {0, WINDOW_HEIGHT(game->variant) - 50, WINDOW_WIDTH(game->variant), 50};
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderFillRect(renderer, &messageRect);
+
+    SDL_Color textColor = {0, 0, 0, 255};
+    const char* message = !game->vsComputer ? (game->currentPlayer == PLAYER1 ? "Vez do jogador 1!" : "Vez do jogador 2!")
+                        : game->currentPlayer == PLAYER1 ? "Sua vez!" : "Vez do computador!";
+
+    const TextEntry* entry = cachedText(renderer, cache, font, message, textColor);
+    if (entry) {
+        SDL_Rect textRect = {10, WINDOW_HEIGHT(game->variant) - 45, entry->width, entry->height};
+        SDL_RenderCopy(renderer, entry->texture, nullptr, &textRect);
+    }
+}
+
+// Cor das peças de cada jogador; NONE é a cor das casas vazias.
+static SDL_Color discColor(Player player) {
+    if (player == PLAYER1) {
+        return (SDL_Color){255, 0, 0, 255};    // Vermelho
+    } else if (player == PLAYER2) {
+        return (SDL_Color){255, 255, 0, 255};  // Amarelo
+    }
+    return (SDL_Color){255, 255, 255, 255};    // Branco
+}
+
+// Função para rasterizar um disco com bordas suavizadas (4x4 amostras por pixel) em uma textura.
+static SDL_Texture* createDiscTexture(SDL_Renderer* renderer, int radius, SDL_Color color) {
+    int size = radius * 2;
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        return nullptr;
+    }
+    for (int y = 0; y < size; ++y) {
+        Uint8* row = (Uint8*)surface->pixels + y * surface->pitch;
+        for (int x = 0; x < size; ++x) {
+            int covered = 0;
+            for (int sy = 0; sy < 4; ++sy) {
+                for (int sx = 0; sx < 4; ++sx) {
+                    float dx = x + (sx + 0.5f) / 4 - radius;
+                    float dy = y + (sy + 0.5f) / 4 - radius;
+                    covered += dx * dx + dy * dy <= (float)(radius * radius);
+                }
+            }
+            Uint8* pixel = row + x * 4;
+            pixel[0] = color.r;
+            pixel[1] = color.g;
+            pixel[2] = color.b;
+            pixel[3] = (Uint8)(color.a * covered / 16);
+        }
+    }
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (texture) {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+    return texture;
+}
+
+// Desenha o fundo azul e as casas vazias (no destino atual do renderizador).
+static void drawEmptyBoard(SDL_Renderer* renderer, const RenderCache* cache) {
+    SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255);  // Fundo azul do tabuleiro
+    SDL_RenderClear(renderer);
+    for (int row = 0; row < cache->variant->rows; ++row) {
+        for (int col = 0; col < cache->variant->cols; ++col) {
+            drawDisc(renderer, cache, NONE, col * TILE_SIZE + TILE_SIZE / 2, row * TILE_SIZE + TILE_SIZE / 2 + 50);
+        }
+    }
+}
+
+// Função para criar as texturas dos discos e do tabuleiro vazio (na inicialização ou após a perda
+// das texturas pelo renderizador).
+bool initRenderCache(SDL_Renderer* renderer, RenderCache* cache, const BoardVariant* variant) {
+    *cache = (RenderCache){.variant = variant};
+    for (Player player = NONE; player <= PLAYER2; ++player) {
+        cache->discs[player] = createDiscTexture(renderer, CIRCLE_RADIUS, discColor(player));
+        if (!cache->discs[player]) {
+            freeRenderCache(cache);
+            return false;
+        }
+    }
+
+    // Sem suporte a texturas de destino o tabuleiro vazio é desenhado a cada quadro
+    cache->board = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                     WINDOW_WIDTH(variant), WINDOW_HEIGHT(variant));
+    if (cache->board) {
+        if (SDL_SetRenderTarget(renderer, cache->board) == 0) {
+            drawEmptyBoard(renderer, cache);
+            SDL_SetRenderTarget(renderer, nullptr);
+        } else {
+            SDL_DestroyTexture(cache->board);
+            cache->board = nullptr;
+        }
+    }
+    return true;
+}
+
+void freeRenderCache(RenderCache* cache) {
+    for (int i = 0; i < 3; ++i) {
+        if (cache->discs[i]) {
+            SDL_DestroyTexture(cache->discs[i]);
+        }
+    }
+    if (cache->board) {
+        SDL_DestroyTexture(cache->board);
+    }
+    for (int i = 0; i < TEXT_CACHE_SIZE; ++i) {
+        if (cache->texts[i].texture) {
+            SDL_DestroyTexture(cache->texts[i].texture);
+        }
+    }
+    *cache = (RenderCache){.variant = cache->variant};
+}
+
+// Função auxiliar para desenhar uma peça (ou uma casa vazia) centrada em uma posição da tela.
+void drawDisc(SDL_Renderer* renderer, const RenderCache* cache, Player player, int centerX, int centerY) {
+    SDL_Rect rect = {centerX - CIRCLE_RADIUS, centerY - CIRCLE_RADIUS, CIRCLE_RADIUS * 2, CIRCLE_RADIUS * 2};
+    SDL_RenderCopy(renderer, cache->discs[player], nullptr, &rect);
+}
+
+// Função para obter a textura de um texto, rasterizando-o só na primeira vez. Quando o cache enche, a
+// entrada usada há mais tempo é descartada. Devolve nullptr se o texto não puder ser rasterizado.
+const TextEntry* cachedText(SDL_Renderer* renderer, RenderCache* cache, TTF_Font* font, const char* text, SDL_Color color) {
+    TextEntry* oldest = &cache->texts[0];
+    cache->textClock++;
+    for (int i = 0; i < TEXT_CACHE_SIZE; ++i) {
+        TextEntry* entry = &cache->texts[i];
+        if (entry->texture && entry->font == font && entry->color.r == color.r && entry->color.g == color.g &&
+            entry->color.b == color.b && entry->color.a == color.a && strcmp(entry->text, text) == 0) {
+            entry->lastUsed = cache->textClock;
+            return entry;
+        }
+        if (!entry->texture || (oldest->texture && entry->lastUsed < oldest->lastUsed)) {
+            oldest = entry;
+        }
+    }
+
+    if (!font || strlen(text) >= TEXT_CACHE_MAX_LENGTH) {
+        return nullptr;
+    }
+    SDL_Surface* surface = TTF_RenderText_Solid(font, text, color);
+    if (!surface) {
+        return nullptr;
+    }
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    int width = surface->w;
+    int height = surface->h;
+    SDL_FreeSurface(surface);
+    if (!texture) {
+        return nullptr;
+    }
+
+    if (oldest->texture) {
+        SDL_DestroyTexture(oldest->texture);
+    }
+    *oldest = (TextEntry){.font = font, .color = color, .texture = texture, .width = width, .height = height,
+                          .lastUsed = cache->textClock};
+    strcpy(oldest->text, text);
+    return oldest;
+}
+
+// Função para desenhar o tabuleiro e as peças, incluindo a peça suspensa e a animação de queda.
+void drawBoard(SDL_Renderer* renderer, const RenderCache* cache, const Game* game) {
+    if (cache->board) {
+        SDL_RenderCopy(renderer, cache->board, nullptr, nullptr);
+    } else {
+        drawEmptyBoard(renderer, cache);
+    }
+
+    // Desenha a peça suspensa (onde o jogador pretende colocar a peça)
+    if (game->selectedCol >= 0 && game->selectedCol < game->variant->cols && !game->isDropping) {
+        int centerX = game->selectedCol * TILE_SIZE + TILE_SIZE / 2;
+        drawDisc(renderer, cache, game->currentPlayer, centerX, HIGHLIGHT_POSITION);
+    }
+
+    // Desenha as peças no tabuleiro; as casas vazias já estão no fundo
+    for (int row = 0; row < game->variant->rows; ++row) {
+        for (int col = 0; col < game->variant->cols; ++col) {
+            Player owner = game->variant->cellOwner(&game->position, row, col);
+            if (owner != NONE) {
+                int centerX = col * TILE_SIZE + TILE_SIZE / 2;
+                int centerY = row * TILE_SIZE + TILE_SIZE / 2 + 50; // Desloca o tabuleiro para baixo
+                drawDisc(renderer, cache, owner, centerX, centerY);
+            }
+        }
+    }
+
+    // Desenha a peça caindo (durante a animação de queda)
+    if (game->isDropping) {
+        int centerX = game->selectedCol * TILE_SIZE + TILE_SIZE / 2;
+        drawDisc(renderer, cache, game->currentPlayer, centerX, game->dropY);
+    }
+}
+
+void drawButton(SDL_Renderer* renderer, RenderCache* cache, TTF_Font* font, SDL_Rect buttonRect, const char* buttonText) {
+    // Configura as cores do botão
+    SDL_Color borderColor = {200, 200, 200, 255};    // Cinza claro para a borda
+    SDL_Color fillColor = {100, 149, 237, 255};      // Azul claro para o fundo do botão
+    SDL_Color textColor = {255, 255, 255, 255};      // Branco para o texto
+
+    // Desenha o fundo do botão
+    SDL_SetRenderDrawColor(renderer, fillColor.r, fillColor.g, fillColor.b, fillColor.a);
+    SDL_RenderFillRect(renderer, &buttonRect);
+
+    // Desenha a borda do botão
+    SDL_SetRenderDrawColor(renderer, borderColor.r, borderColor.g, borderColor.b, borderColor.a);
+    SDL_RenderDrawRect(renderer, &buttonRect);
+
+    // Desenha o texto do botão
+    const TextEntry* entry = cachedText(renderer, cache, font, buttonText, textColor);
+    if (!entry) {
+        return;
+    }
+
+    // Centraliza o texto no botão
+    SDL_Rect textRect = {
+        buttonRect.x + (buttonRect.w - entry->width) / 2,
+        buttonRect.y + (buttonRect.h - entry->height) / 2,
+        entry->width,
+        entry->height
+    };
+    SDL_RenderCopy(renderer, entry->texture, nullptr, &textRect);
+}
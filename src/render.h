@@ -0,0 +1,55 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include "game.h"
+#include "hud.h"
+
+// Desenho das telas do jogo. Não cria janela nem renderizador: desenha em qualquer SDL_Renderer, o da
+// janela do jogo ou um renderizador por software sem tela (c4renderbench).
+
+#define TILE_SIZE 100
+#define WINDOW_WIDTH(variant) ((variant)->cols * TILE_SIZE)
+#define WINDOW_HEIGHT(variant) ((variant)->rows * TILE_SIZE + 100)  // Altura extra para a peça suspensa
+#define CIRCLE_RADIUS (TILE_SIZE / 2 - 10)
+#define HIGHLIGHT_POSITION (TILE_SIZE / 2 - 50)
+#define TEXT_CACHE_SIZE 32 // Textos rasterizados mantidos em textura
+#define TEXT_CACHE_MAX_LENGTH 64
+
+// Texto já rasterizado, identificado pelo conteúdo, cor e fonte (cada TTF_Font tem um tamanho fixo).
+typedef struct {
+    char text[TEXT_CACHE_MAX_LENGTH];
+    TTF_Font* font;
+    SDL_Color color;
+    SDL_Texture* texture;
+    int width;
+    int height;
+    Uint32 lastUsed;  // Marca de uso, para descartar a entrada usada há mais tempo quando o cache enche
+} TextEntry;
+
+// Texturas pré-renderizadas: cada disco é rasterizado uma vez e o tabuleiro vazio fica guardado em uma
+// textura de destino, então um quadro custa uma cópia do tabuleiro e uma cópia por peça.
+typedef struct {
+    const BoardVariant* variant;  // Tamanho do tabuleiro guardado em board
+    SDL_Texture* discs[3];  // Indexado por Player: NONE é o disco branco das casas vazias
+    SDL_Texture* board;     // Fundo azul com as casas vazias (nullptr se o renderizador não suportar)
+    TextEntry texts[TEXT_CACHE_SIZE];
+    Uint32 textClock;
+} RenderCache;
+
+bool initRenderCache(SDL_Renderer* renderer, RenderCache* cache, const BoardVariant* variant);
+void freeRenderCache(RenderCache* cache);
+void drawBoard(SDL_Renderer* renderer, const RenderCache* cache, const Game* game);
+void drawScene(SDL_Renderer* renderer, RenderCache* cache, const Scene* scene, const Game* game, TTF_Font* font,
+               HudTimings* timings);
+void drawGameOver(SDL_Renderer* renderer, RenderCache* cache, const Scene* scene, const Game* game, TTF_Font* font);
+void drawDisc(SDL_Renderer* renderer, const RenderCache* cache, Player player, int centerX, int centerY);
+const TextEntry* cachedText(SDL_Renderer* renderer, RenderCache* cache, TTF_Font* font, const char* text, SDL_Color color);
+void displayTurn(SDL_Renderer* renderer, RenderCache* cache, const Game* game, TTF_Font* font);
+void drawPrompt(SDL_Renderer* renderer, RenderCache* cache, TTF_Font* font, const char* message,
+                const char* firstText, const char* secondText);
+int promptButtonAt(const BoardVariant* variant, int x, int y);
+void drawButton(SDL_Renderer* renderer, RenderCache* cache, TTF_Font* font, SDL_Rect buttonRect, const char* buttonText);
+
+#endif
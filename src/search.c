@@ -0,0 +1,508 @@
+#include "search.h"
+#include <stdatomic.h>
+#include <threads.h>
+#include "clock.h"
+
+// Intervalo (em nós) entre verificações do relógio e do sinal de parada durante a busca.
+#define CLOCK_CHECK_INTERVAL 4096
+#define STOP_CHECK_INTERVAL 256
+
+// Estado de uma thread de busca. A thread principal (id 0) produz o resultado; as auxiliares só
+// preenchem a tabela de transposição compartilhada (Lazy SMP).
+typedef struct {
+    Engine* engine;
+    const Position* root;
+    atomic_bool* stop;     // Sinal de parada compartilhado entre as threads
+    atomic_bool* cancel;   // Sinal de cancelamento de quem chamou (só a thread principal o consulta)
+    int id;
+    int maxDepth;
+    TTStats ttStats;
+    uint64_t nodes;
+    uint64_t endgameHits;  // Posições resolvidas pelo banco de finais
+    uint64_t nodeLimit;
+    uint64_t deadlineUs;   // 0 = sem limite de tempo
+    bool canAbort;         // A primeira iteração sempre termina, para haver uma jogada válida
+    bool exactKeys;        // A tabela de transposição identifica as posições sem ambiguidade (ver tt.h)
+    bool aborted;
+} SearchContext;
+
+// i-ésima coluna na ordem de preferência: do centro para as bordas.
+static inline int columnAt(int i) {
+    return COLS / 2 + (i % 2 == 0 ? i / 2 : -(i + 1) / 2);
+}
+
+// Pesos da avaliação estática, por janela de quatro casas ou por casa de ameaça.
+#define EVAL_TWO 2             // Janela sem peças do adversário com duas peças próprias
+#define EVAL_THREE 6           // Janela sem peças do adversário com três peças próprias
+#define EVAL_THREAT 10         // Casa vencedora na paridade de linha que favorece o jogador
+#define EVAL_THREAT_OTHER 4    // Casa vencedora na outra paridade
+// A soma é arredondada para múltiplos deste valor: diferenças pequenas entre folhas deixam de valer uma
+// nova busca, e a poda corta mais cedo
+#define EVAL_GRAIN 8
+
+// Função para somar os pontos de um jogador nas janelas de quatro casas de uma direção. As janelas são
+// contadas em paralelo: cada bit de um bitboard representa a janela que começa naquela casa, e as quatro
+// casas de cada janela são somadas bit a bit (um somador por bit) antes da contagem final.
+static inline int evaluateWindows(Bitboard own, Bitboard open, int shift) {
+    // Janelas inteiras dentro do tabuleiro e sem peças do adversário
+    Bitboard windows = open & (open >> shift) & (open >> 2 * shift) & (open >> 3 * shift);
+    Bitboard a = own;
+    Bitboard b = own >> shift;
+    Bitboard c = own >> 2 * shift;
+    Bitboard d = own >> 3 * shift;
+    Bitboard ones = a ^ b ^ c ^ d;                               // Bit 0 da soma
+    Bitboard twos = (a & b) ^ (c & d) ^ ((a ^ b) & (c ^ d));     // Bit 1 da soma
+    return EVAL_TWO * bitboardCount(windows & twos & ~ones) + EVAL_THREE * bitboardCount(windows & twos & ones);
+}
+
+// Pontos de um jogador nas janelas de todas as direções.
+static int evaluatePlayer(Bitboard own, Bitboard opponent) {
+    Bitboard open = bitboardCells() & ~opponent;
+    return evaluateWindows(own, open, SHIFT_VERTICAL) + evaluateWindows(own, open, SHIFT_HORIZONTAL) +
+           evaluateWindows(own, open, SHIFT_DIAGONAL_UP) + evaluateWindows(own, open, SHIFT_DIAGONAL_DOWN);
+}
+
+// Avaliação estática de uma posição sem vitória imediata, do ponto de vista do jogador da vez: janelas
+// abertas com duas e três peças e casas vencedoras (ameaças), pesadas pela paridade da linha (nas linhas
+// ímpares as ameaças favorecem o jogador 1; nas pares, o jogador 2). Fica sempre fora da faixa decisiva.
+static int evaluate(const Position* pos, Bitboard ownThreats, Bitboard opponentThreats) {
+    Bitboard own = pos->current;
+    Bitboard opponent = pos->current ^ pos->mask;
+    Bitboard oddRows = bitboardOddRows();
+    Bitboard ownParity = positionPlayerToMove(pos) == PLAYER1 ? oddRows : bitboardCells() ^ oddRows;
+
+    int score = evaluatePlayer(own, opponent) - evaluatePlayer(opponent, own);
+    score += EVAL_THREAT * bitboardCount(ownThreats & ownParity) +
+             EVAL_THREAT_OTHER * bitboardCount(ownThreats & ~ownParity);
+    score -= EVAL_THREAT * bitboardCount(opponentThreats & ~ownParity) +
+             EVAL_THREAT_OTHER * bitboardCount(opponentThreats & ownParity);
+    score = score >= 0 ? (score + EVAL_GRAIN / 2) / EVAL_GRAIN : -((-score + EVAL_GRAIN / 2) / EVAL_GRAIN);
+    if (score > SCORE_DECISIVE) {
+        score = SCORE_DECISIVE;
+    } else if (score < -SCORE_DECISIVE) {
+        score = -SCORE_DECISIVE;
+    }
+    return score;
+}
+
+// Função para obter as casas jogáveis que não perdem na jogada seguinte do adversário: se ele tem uma casa
+// vencedora jogável, só ela serve; e nenhuma jogada pode ficar logo abaixo de uma casa vencedora dele.
+static Bitboard nonLosingMoves(Bitboard playable, Bitboard opponentThreats) {
+    Bitboard forced = playable & opponentThreats;
+    if (forced) {
+        if (forced & (forced - 1)) {
+            return 0;  // Duas ameaças jogáveis: não há como bloquear as duas
+        }
+        playable = forced;
+    }
+    return playable & ~(opponentThreats >> 1);
+}
+
+// Função para ordenar as jogadas candidatas pela quantidade de casas vencedoras que cada uma deixa para o
+// jogador e, no empate, do centro para as bordas. Grava também essas casas, que o filho usa como as
+// ameaças do adversário sem recalculá-las. Devolve o número de jogadas.
+static int orderMoves(const Position* pos, Bitboard candidates, int order[], Bitboard threats[]) {
+    int priority[COLS];
+    int count = 0;
+    for (int i = 0; i < COLS; ++i) {
+        int col = columnAt(i);
+        Bitboard move = positionMoveBit(pos, col);
+        if (!(candidates & move)) {
+            continue;
+        }
+        Bitboard created = bitboardWinningCells(pos->current | move, pos->mask | move);
+        int value = bitboardCount(created);
+        int j = count++;
+        for (; j > 0 && priority[j - 1] < value; --j) {
+            order[j] = order[j - 1];
+            priority[j] = priority[j - 1];
+            threats[j] = threats[j - 1];
+        }
+        order[j] = col;
+        priority[j] = value;
+        threats[j] = created;
+    }
+    return count;
+}
+
+// Função para verificar se a busca deve parar por tempo ou por número de nós.
+static bool shouldAbort(SearchContext* ctx) {
+    if (!ctx->canAbort) {
+        return false;
+    }
+    if (ctx->nodes % STOP_CHECK_INTERVAL == 0 && (atomic_load_explicit(ctx->stop, memory_order_relaxed) ||
+            (ctx->cancel && atomic_load_explicit(ctx->cancel, memory_order_relaxed)))) {
+        ctx->aborted = true;
+    } else if (ctx->nodeLimit && ctx->nodes >= ctx->nodeLimit) {
+        ctx->aborted = true;
+    } else if (ctx->deadlineUs && ctx->nodes % CLOCK_CHECK_INTERVAL == 0 && clockNowUs() >= ctx->deadlineUs) {
+        ctx->aborted = true;
+    }
+    return ctx->aborted;
+}
+
+// Negamax com poda alfa-beta; devolve a pontuação do ponto de vista do jogador da vez. As casas vencedoras
+// dos dois jogadores chegam prontas do pai, que já as calculou ao ordenar as jogadas.
+static int negamax(SearchContext* ctx, const Position* pos, int depth, int alpha, int beta, Bitboard ownThreats,
+                   Bitboard opponentThreats) {
+    ctx->nodes++;
+    if (shouldAbort(ctx)) {
+        return 0;
+    }
+
+    Bitboard playable = positionPlayableCells(pos);
+    if (playable & ownThreats) {
+        return SCORE_WIN - (pos->moves + 1);
+    }
+    if (pos->moves >= ROWS * COLS - 1) {
+        return 0;  // A última casa não pode vencer (já verificado acima): empate
+    }
+    // Uma posição do banco de finais tem valor exato: a busca não desce abaixo dela
+    int tabulated;
+    if (ctx->engine->endgame && endgameProbe(ctx->engine->endgame, pos, &tabulated)) {
+        ctx->endgameHits++;
+        return tabulated;
+    }
+    Bitboard candidates = nonLosingMoves(playable, opponentThreats);
+    if (!candidates) {
+        return -(SCORE_WIN - (pos->moves + 2));  // Toda jogada deixa o adversário vencer em seguida
+    }
+    if (depth == 0) {
+        return evaluate(pos, ownThreats, opponentThreats);
+    }
+
+    // Sem vitória imediata, o melhor possível é vencer na próxima jogada própria
+    int best = SCORE_WIN - (pos->moves + 3);
+    if (beta > best) {
+        beta = best;
+        if (alpha >= beta) {
+            return beta;
+        }
+    }
+
+    uint64_t key = positionKey(pos);
+    int ttMove = -1;
+    TTEntry entry;
+    if (ttProbe(&ctx->engine->tt, key, &entry, &ctx->ttStats)) {
+        ttMove = entry.move;
+        // Só entradas da mesma profundidade podem cortar a busca: assim o valor na raiz não depende de
+        // quais entradas (de outras threads ou buscas) ainda estão na tabela, e o resultado é determinístico.
+        // Sem identificação exata (tabuleiros maiores que 7x6), uma entrada de outra posição pode passar pela
+        // verificação: pontuações decisivas da tabela não cortam a busca, para um falso acerto não virar um
+        // resultado resolvido errado.
+        if (entry.depth == depth && (ctx->exactKeys || !scoreIsDecisive(entry.score))) {
+            if (entry.bound == BOUND_EXACT) {
+                return entry.score;
+            }
+            if (entry.bound == BOUND_LOWER && entry.score > alpha) {
+                alpha = entry.score;
+            } else if (entry.bound == BOUND_UPPER && entry.score < beta) {
+                beta = entry.score;
+            }
+            if (alpha >= beta) {
+                return entry.score;
+            }
+        }
+    }
+
+    // A coluna guardada na tabela é testada primeiro, antes de as demais serem ordenadas: quando ela corta a
+    // busca, as casas vencedoras das outras jogadas nem chegam a ser calculadas
+    int order[COLS];
+    Bitboard threats[COLS];
+    int count;
+    Bitboard ttBit = ttMove >= 0 ? candidates & positionMoveBit(pos, ttMove) : 0;
+    if (ttBit) {
+        order[0] = ttMove;
+        threats[0] = bitboardWinningCells(pos->current | ttBit, pos->mask | ttBit);
+        count = 1;
+    } else {
+        count = orderMoves(pos, candidates, order, threats);
+    }
+
+    int alphaOrig = alpha;
+    int bestMove = -1;
+    for (int i = 0; i < count; ++i) {
+        int col = order[i];
+        Position child = *pos;
+        positionPlay(&child, col);
+        // No filho a vez é do adversário, cujas casas vencedoras não mudam, exceto a casa recém-ocupada
+        int score = -negamax(ctx, &child, depth - 1, -beta, -alpha, opponentThreats & ~positionMoveBit(pos, col),
+                             threats[i]);
+        if (ctx->aborted) {
+            return 0;
+        }
+        if (score >= beta) {
+            ttStore(&ctx->engine->tt, key, depth, BOUND_LOWER, score, col, &ctx->ttStats);
+            return score;
+        }
+        if (score > alpha) {
+            alpha = score;
+            bestMove = col;
+        }
+        if (i == 0 && ttBit) {
+            count += orderMoves(pos, candidates & ~ttBit, order + 1, threats + 1);
+        }
+    }
+    ttStore(&ctx->engine->tt, key, depth, alpha > alphaOrig ? BOUND_EXACT : BOUND_UPPER, alpha, bestMove,
+            &ctx->ttStats);
+    return alpha;
+}
+
+// Função para buscar a raiz em uma profundidade fixa, testando primeiro a melhor coluna anterior.
+// Em caso de empate vence a coluna testada antes, o que mantém o resultado determinístico.
+static int searchRoot(SearchContext* ctx, const Position* pos, int depth, int* bestCol) {
+    int order[COLS];
+    int count = 0;
+    if (*bestCol >= 0) {
+        order[count++] = *bestCol;
+    }
+    for (int i = 0; i < COLS; ++i) {
+        if (columnAt(i) != *bestCol && positionCanPlay(pos, columnAt(i))) {
+            order[count++] = columnAt(i);
+        }
+    }
+    // As threads auxiliares começam por colunas diferentes para explorar outras partes da árvore
+    if (ctx->id > 0 && count > 1) {
+        int rotated[COLS];
+        for (int i = 0; i < count; ++i) {
+            rotated[i] = order[(i + ctx->id) % count];
+        }
+        for (int i = 0; i < count; ++i) {
+            order[i] = rotated[i];
+        }
+    }
+
+    int alpha = -SCORE_INFINITY;
+    int best = -1;
+    for (int i = 0; i < count; ++i) {
+        int col = order[i];
+        int score;
+        if (positionWinsWith(pos, col, positionPlayerToMove(pos))) {
+            score = SCORE_WIN - (pos->moves + 1);
+        } else {
+            Position child = *pos;
+            positionPlay(&child, col);
+            score = -negamax(ctx, &child, depth - 1, -SCORE_INFINITY, -alpha,
+                             bitboardWinningCells(child.current, child.mask),
+                             bitboardWinningCells(child.current ^ child.mask, child.mask));
+            if (ctx->aborted) {
+                return 0;
+            }
+        }
+        if (score > alpha) {
+            alpha = score;
+            best = col;
+        }
+    }
+    *bestCol = best;
+    return alpha;
+}
+
+// Função para obter o valor exato de uma posição sem busca: vitória imediata, empate na última casa ou
+// consulta ao banco de finais.
+static bool endgameValue(const EndgameTable* table, const Position* pos, int* score) {
+    for (int col = 0; col < COLS; ++col) {
+        if (positionCanPlay(pos, col) && positionWinsWith(pos, col, positionPlayerToMove(pos))) {
+            *score = SCORE_WIN - (pos->moves + 1);
+            return true;
+        }
+    }
+    if (pos->moves >= ROWS * COLS - 1) {
+        *score = 0;
+        return true;
+    }
+    return endgameProbe(table, pos, score);
+}
+
+// Função para resolver a raiz pelo banco de finais quando o valor de todas as jogadas está tabelado.
+// Em caso de empate vence a coluna mais central, como na busca.
+static bool endgameRootMove(const EndgameTable* table, const Position* pos, SearchResult* result) {
+    if (pos->moves < table->minMoves - 1) {
+        return false;
+    }
+    int bestCol = -1;
+    int best = -SCORE_INFINITY;
+    for (int i = 0; i < COLS; ++i) {
+        int col = columnAt(i);
+        if (!positionCanPlay(pos, col)) {
+            continue;
+        }
+        int score;
+        if (positionWinsWith(pos, col, positionPlayerToMove(pos))) {
+            score = SCORE_WIN - (pos->moves + 1);
+        } else {
+            Position child = *pos;
+            positionPlay(&child, col);
+            if (!endgameValue(table, &child, &score)) {
+                return false;
+            }
+            score = -score;
+        }
+        if (score > best) {
+            best = score;
+            bestCol = col;
+        }
+    }
+    *result = (SearchResult){
+        .bestCol = bestCol,
+        .score = best,
+        .depth = ROWS * COLS - pos->moves,
+        .solved = true,
+        .fromEndgame = true,
+    };
+    return bestCol >= 0;
+}
+
+bool engineInit(Engine* engine, size_t ttMegabytes) {
+    *engine = (Engine){0};
+    return ttInit(&engine->tt, ttMegabytes);
+}
+
+void engineFree(Engine* engine) {
+    ttFree(&engine->tt);
+}
+
+// Laço de uma thread auxiliar: aprofundamento iterativo até receber o sinal de parada. Metade das
+// auxiliares busca uma profundidade à frente da principal; seus resultados chegam a ela pela tabela.
+static int helperMain(void* arg) {
+    SearchContext* ctx = arg;
+    int bestCol = -1;
+    ctx->canAbort = true;
+    for (int depth = 1 + ctx->id % 2; depth <= ctx->maxDepth; ++depth) {
+        searchRoot(ctx, ctx->root, depth, &bestCol);
+        if (ctx->aborted) {
+            break;
+        }
+    }
+    return 0;
+}
+
+SearchResult searchBestMove(Engine* engine, const Position* pos, const SearchLimits* limits) {
+    uint64_t start = clockNowUs();
+
+    // Só resultados exatos do livro substituem a busca: uma entrada gravada com limite de tempo ou de
+    // profundidade pode ser mais rasa que a busca que está sendo pedida
+    BookMove bookMove;
+    if (engine->book && bookProbe(engine->book, pos, &bookMove) && bookMove.solved) {
+        return (SearchResult){
+            .bestCol = bookMove.col,
+            .score = bookMove.score,
+            .depth = bookMove.depth,
+            .solved = bookMove.solved,
+            .fromBook = true,
+            .elapsedUs = clockNowUs() - start,
+        };
+    }
+
+    SearchResult tabulated;
+    if (engine->endgame && endgameRootMove(engine->endgame, pos, &tabulated)) {
+        tabulated.elapsedUs = clockNowUs() - start;
+        return tabulated;
+    }
+
+    ttNewSearch(&engine->tt);
+
+    int remaining = ROWS * COLS - pos->moves;
+    int maxDepth = (limits->maxDepth > 0 && limits->maxDepth < remaining) ? limits->maxDepth : remaining;
+
+    atomic_bool stop = false;
+    bool exactKeys = POSITION_KEY_UNIQUE && POSITION_KEY_BITS <= engine->tt.exactKeyBits;
+    SearchContext ctx = {
+        .engine = engine,
+        .root = pos,
+        .stop = &stop,
+        .cancel = limits->cancel,
+        .maxDepth = maxDepth,
+        .nodeLimit = limits->nodeLimit,
+        .deadlineUs = limits->timeLimitMs ? start + (uint64_t)limits->timeLimitMs * 1000u : 0,
+        .exactKeys = exactKeys,
+    };
+
+    int helperCount = limits->threads > 1 ? limits->threads - 1 : 0;
+    if (helperCount > SEARCH_MAX_THREADS - 1) {
+        helperCount = SEARCH_MAX_THREADS - 1;
+    }
+    SearchContext helpers[SEARCH_MAX_THREADS - 1];
+    thrd_t threads[SEARCH_MAX_THREADS - 1];
+    int started = 0;
+    for (; started < helperCount; ++started) {
+        helpers[started] = (SearchContext){
+            .engine = engine, .root = pos, .stop = &stop, .id = started + 1, .maxDepth = maxDepth,
+            .exactKeys = exactKeys,
+        };
+        if (thrd_create(&threads[started], helperMain, &helpers[started]) != thrd_success) {
+            break;
+        }
+    }
+
+    SearchResult result = {.bestCol = -1};
+    int bestCol = -1;
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        ctx.canAbort = depth > 1;
+        uint64_t endgameHits = ctx.endgameHits;
+        int score = searchRoot(&ctx, pos, depth, &bestCol);
+        if (ctx.aborted) {
+            break;
+        }
+        result.bestCol = bestCol;
+        result.score = score;
+        result.depth = depth;
+        // Uma vitória encontrada antes do horizonte é a mais rápida só sem o banco de finais: ele pode trazer
+        // de longe uma vitória mais lenta que outra ainda além do horizonte
+        result.solved = depth == remaining || (scoreIsDecisive(score) && ctx.endgameHits == endgameHits);
+        if (result.solved || bestCol < 0) {
+            break;
+        }
+    }
+
+    atomic_store(&stop, true);
+    result.cancelled = limits->cancel && atomic_load(limits->cancel);
+    result.nodes = ctx.nodes;
+    result.tt = ctx.ttStats;
+    for (int i = 0; i < started; ++i) {
+        thrd_join(threads[i], nullptr);
+        result.nodes += helpers[i].nodes;
+        ttStatsAdd(&result.tt, &helpers[i].ttStats);
+    }
+    ttStatsAdd(&engine->ttStats, &result.tt);
+    result.elapsedUs = clockNowUs() - start;
+    return result;
+}
+
+// Procura uma coluna em que o jogador venceria imediatamente.
+static int findWinningMove(const Position* pos, Player player) {
+    for (int col = 0; col < COLS; ++col) {
+        if (positionCanPlay(pos, col) && positionWinsWith(pos, col, player)) {
+            return col;
+        }
+    }
+    return -1;
+}
+
+int searchHeuristicMove(const Position* pos) {
+    Player me = positionPlayerToMove(pos);
+
+    // 1. Verifica se pode vencer na próxima jogada
+    int winningMove = findWinningMove(pos, me);
+    if (winningMove != -1) {
+        return winningMove;
+    }
+
+    // 2. Bloqueia a vitória imediata do adversário
+    int blockingMove = findWinningMove(pos, otherPlayer(me));
+    if (blockingMove != -1) {
+        return blockingMove;
+    }
+
+    // 3. Prioriza o centro e depois as colunas mais próximas dele
+    int centerColumn = COLS / 2;
+    for (int offset = 0; offset <= COLS / 2; ++offset) {
+        if (positionCanPlay(pos, centerColumn - offset)) {
+            return centerColumn - offset;
+        }
+        if (positionCanPlay(pos, centerColumn + offset)) {
+            return centerColumn + offset;
+        }
+    }
+    return -1;  // Nenhuma coluna disponível
+}
@@ -0,0 +1,78 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "book.h"
+#include "endgame.h"
+#include "position.h"
+#include "tt.h"
+
+// Pontuação do ponto de vista do jogador da vez: uma vitória vale SCORE_WIN menos o número de peças
+// no tabuleiro após a jogada vencedora (vitórias mais rápidas valem mais), uma derrota vale o
+// negativo disso e o empate vale 0. Quando a busca para no horizonte, a avaliação estática dá à posição
+// um valor entre -SCORE_DECISIVE e SCORE_DECISIVE (positivo quando favorece o jogador da vez).
+#define SCORE_WIN 1000
+#define SCORE_INFINITY (SCORE_WIN + 1)
+#define SCORE_DECISIVE (SCORE_WIN - ROWS * COLS)
+
+#define SEARCH_MAX_THREADS 64
+
+// Limites de uma busca; um campo igual a 0 significa "sem limite".
+typedef struct {
+    int maxDepth;          // Profundidade máxima em meias-jogadas
+    uint32_t timeLimitMs;  // Tempo máximo de relógio por jogada
+    uint64_t nodeLimit;    // Número máximo de nós visitados pela thread principal
+    int threads;           // Threads de busca (0 ou 1 = só a thread que chamou)
+    atomic_bool* cancel;   // Se não for nullptr, outra thread pode interromper a busca tornando-o verdadeiro
+} SearchLimits;
+
+typedef struct {
+    int bestCol;           // Melhor coluna encontrada (-1 se não há jogadas)
+    int score;             // Pontuação da melhor coluna
+    int depth;             // Profundidade da última iteração completa
+    bool solved;           // A pontuação é exata (a busca chegou ao fim do jogo)
+    bool fromBook;         // Resposta encontrada no livro de aberturas
+    bool fromEndgame;      // Resposta calculada com o banco de finais, sem busca
+    bool cancelled;        // A busca foi interrompida por SearchLimits.cancel
+    uint64_t nodes;        // Nós visitados em todas as iterações (no MCTS, nós criados na árvore)
+    uint64_t playouts;     // Partidas simuladas até o fim (só no MCTS, ver mcts.h)
+    uint64_t elapsedUs;    // Tempo total da busca
+    TTStats tt;            // Uso da tabela de transposição nesta busca
+} SearchResult;
+
+// Estado persistente entre buscas.
+typedef struct {
+    TranspositionTable tt;
+    TTStats ttStats;       // Uso acumulado da tabela de transposição
+    const OpeningBook* book; // Livro de aberturas consultado antes da busca (opcional; só entradas resolvidas)
+    const EndgameTable* endgame; // Banco de finais consultado durante a busca (opcional)
+} Engine;
+
+// Função para inicializar o motor com uma tabela de transposição de até ttMegabytes (0 desativa a tabela).
+bool engineInit(Engine* engine, size_t ttMegabytes);
+void engineFree(Engine* engine);
+
+// Função para criar uma visão de outro motor com a mesma tabela de transposição, livro e banco de finais, para
+// buscar posições diferentes ao mesmo tempo; cada visão tem seus próprios contadores e geração da
+// tabela. A visão não deve ser liberada com engineFree.
+static inline void engineShare(Engine* view, const Engine* shared) {
+    *view = (Engine){.tt = shared->tt, .book = shared->book, .endgame = shared->endgame};
+}
+
+// Função para buscar a melhor jogada com negamax, poda alfa-beta e aprofundamento iterativo.
+// Não depende da SDL: serve tanto à interface quanto a ferramentas sem janela.
+// Com mais de uma thread, as auxiliares buscam a mesma posição e compartilham a tabela de transposição
+// (Lazy SMP). O resultado de uma profundidade é o mesmo para qualquer número de threads; com limite de
+// tempo ou de nós, só a profundidade alcançada varia.
+SearchResult searchBestMove(Engine* engine, const Position* pos, const SearchLimits* limits);
+
+// Função com a IA original sem busca: vence se puder, bloqueia o adversário e prefere o centro.
+int searchHeuristicMove(const Position* pos);
+
+// Função para verificar se uma pontuação representa vitória ou derrota forçada.
+static inline bool scoreIsDecisive(int score) {
+    return score > SCORE_DECISIVE || score < -SCORE_DECISIVE;
+}
+
+#endif
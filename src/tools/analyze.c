@@ -0,0 +1,346 @@
+// Análise em lote: lê posições da entrada padrão (uma sequência de jogadas por linha) e escreve na saída
+// padrão a pontuação de cada coluna, na ordem da entrada. O trabalho segue em três etapas simultâneas:
+// a thread principal lê e valida blocos de linhas, as threads de busca pontuam os blocos e formatam a
+// saída, e uma thread de escrita envia os blocos prontos na ordem em que foram lidos. Os blocos vivem em
+// um anel de tamanho fixo, então a memória usada não depende do tamanho da entrada.
+//
+// Saída, uma linha por entrada: as jogadas seguidas da pontuação de cada coluna, do ponto de vista do
+// jogador da vez ("-" para coluna cheia), ou das jogadas seguidas de "error" se a posição é inválida
+// ou já terminou.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include "clock.h"
+#include "search.h"
+
+#define ANALYZE_MAX_LINE 64                  // Maior sequência de jogadas aceita (o tabuleiro tem 42 casas)
+#define ANALYZE_OUTPUT_LINE (ANALYZE_MAX_LINE + COLS * 6 + 8)
+#define ANALYZE_MAX_WORKERS 256
+
+typedef enum {
+    CHUNK_FREE,                              // Disponível para a leitura
+    CHUNK_PARSED,                            // Lido, à espera de uma thread de busca
+    CHUNK_SOLVING,
+    CHUNK_SOLVED                             // Saída formatada, à espera da escrita
+} ChunkState;
+
+typedef struct {
+    ChunkState state;
+    int count;
+    char (*moves)[ANALYZE_MAX_LINE + 1];
+    Position* positions;
+    bool* valid;
+    char* output;
+    size_t outputLength;
+} Chunk;
+
+typedef struct {
+    Engine engine;                           // Tabela de transposição compartilhada pelas threads
+    SearchLimits limits;
+    int chunkLines;
+    int slots;
+    Chunk* chunks;                           // Anel indexado por sequence % slots
+
+    mtx_t lock;
+    cnd_t chunkFree;                         // Um bloco foi escrito e liberado
+    cnd_t chunkParsed;
+    cnd_t chunkSolved;
+    uint64_t nextToSolve;                    // Próximo bloco a pontuar
+    uint64_t readChunks;                     // Blocos lidos até agora
+    bool endOfInput;
+
+    uint64_t positions;                      // Posições pontuadas (lido ao fim)
+    uint64_t errors;
+} Analyzer;
+
+// Função para pontuar cada coluna: vitória imediata, empate com o tabuleiro cheio ou o negativo da
+// pontuação da posição resultante para o adversário.
+static void scoreColumns(Engine* engine, const Position* pos, const SearchLimits* limits, int scores[COLS],
+                         bool playable[COLS]) {
+    SearchLimits childLimits = *limits;
+    if (childLimits.maxDepth > 1) {
+        childLimits.maxDepth--;  // A jogada da coluna já conta uma meia-jogada
+    }
+    for (int col = 0; col < COLS; ++col) {
+        playable[col] = positionCanPlay(pos, col);
+        if (!playable[col]) {
+            continue;
+        }
+        if (positionWinsWith(pos, col, positionPlayerToMove(pos))) {
+            scores[col] = SCORE_WIN - (pos->moves + 1);
+            continue;
+        }
+        Position child = *pos;
+        positionPlay(&child, col);
+        scores[col] = positionIsFull(&child) ? 0 : -searchBestMove(engine, &child, &childLimits).score;
+    }
+}
+
+static void solveChunk(Analyzer* analyzer, Engine* engine, Chunk* chunk, uint64_t* errors) {
+    chunk->outputLength = 0;
+    for (int i = 0; i < chunk->count; ++i) {
+        char* out = chunk->output + chunk->outputLength;
+        int length = snprintf(out, ANALYZE_OUTPUT_LINE, "%s", chunk->moves[i]);
+        if (!chunk->valid[i]) {
+            length += snprintf(out + length, ANALYZE_OUTPUT_LINE - (size_t)length, " error");
+            (*errors)++;
+        } else {
+            int scores[COLS];
+            bool playable[COLS];
+            scoreColumns(engine, &chunk->positions[i], &analyzer->limits, scores, playable);
+            for (int col = 0; col < COLS; ++col) {
+                length += playable[col] ? snprintf(out + length, ANALYZE_OUTPUT_LINE - (size_t)length, " %d", scores[col])
+                                        : snprintf(out + length, ANALYZE_OUTPUT_LINE - (size_t)length, " -");
+            }
+        }
+        out[length++] = '\n';
+        chunk->outputLength += (size_t)length;
+    }
+}
+
+static int workerMain(void* arg) {
+    Analyzer* analyzer = arg;
+    Engine engine;
+    engineShare(&engine, &analyzer->engine);
+    uint64_t positions = 0;
+    uint64_t errors = 0;
+
+    mtx_lock(&analyzer->lock);
+    for (;;) {
+        while (analyzer->nextToSolve == analyzer->readChunks && !analyzer->endOfInput) {
+            cnd_wait(&analyzer->chunkParsed, &analyzer->lock);
+        }
+        if (analyzer->nextToSolve == analyzer->readChunks) {
+            break;
+        }
+        Chunk* chunk = &analyzer->chunks[analyzer->nextToSolve++ % (uint64_t)analyzer->slots];
+        chunk->state = CHUNK_SOLVING;
+        mtx_unlock(&analyzer->lock);
+
+        solveChunk(analyzer, &engine, chunk, &errors);
+        positions += (uint64_t)chunk->count;
+
+        mtx_lock(&analyzer->lock);
+        chunk->state = CHUNK_SOLVED;
+        cnd_broadcast(&analyzer->chunkSolved);
+    }
+    analyzer->positions += positions;
+    analyzer->errors += errors;
+    mtx_unlock(&analyzer->lock);
+    return 0;
+}
+
+// Escreve os blocos na ordem da entrada: espera o próximo da sequência mesmo que outros já estejam prontos.
+static int writerMain(void* arg) {
+    Analyzer* analyzer = arg;
+    for (uint64_t sequence = 0;; ++sequence) {
+        Chunk* chunk = &analyzer->chunks[sequence % (uint64_t)analyzer->slots];
+        mtx_lock(&analyzer->lock);
+        while (!(sequence < analyzer->readChunks && chunk->state == CHUNK_SOLVED) &&
+               !(analyzer->endOfInput && sequence == analyzer->readChunks)) {
+            cnd_wait(&analyzer->chunkSolved, &analyzer->lock);
+        }
+        if (sequence == analyzer->readChunks) {
+            mtx_unlock(&analyzer->lock);
+            break;
+        }
+        mtx_unlock(&analyzer->lock);
+
+        fwrite(chunk->output, 1, chunk->outputLength, stdout);
+
+        mtx_lock(&analyzer->lock);
+        chunk->state = CHUNK_FREE;
+        cnd_signal(&analyzer->chunkFree);
+        mtx_unlock(&analyzer->lock);
+    }
+    fflush(stdout);
+    return 0;
+}
+
+// Função para ler a próxima linha da entrada; linhas longas demais são lidas até o fim e marcadas inválidas.
+static bool readLine(char line[ANALYZE_MAX_LINE + 1], bool* tooLong) {
+    if (!fgets(line, ANALYZE_MAX_LINE + 1, stdin)) {
+        return false;
+    }
+    size_t length = strcspn(line, "\r\n");
+    *tooLong = line[length] == '\0' && length == ANALYZE_MAX_LINE && !feof(stdin);
+    if (*tooLong) {
+        int c;
+        while ((c = getchar()) != EOF && c != '\n') {
+        }
+    }
+    line[length] = '\0';
+    return true;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Uso: %s [opções] < POSIÇÕES > PONTUAÇÕES\n"
+            "  --depth D    profundidade de cada coluna, em meias-jogadas (padrão 12)\n"
+            "  --time MS    tempo por coluna (padrão 0 = sem limite)\n"
+            "  --nodes N    nós por coluna (padrão 0 = sem limite)\n"
+            "  --workers W  threads de busca (padrão 4)\n"
+            "  --chunk N    linhas por bloco (padrão 256)\n"
+            "  --hash MB    tabela de transposição compartilhada (padrão 256)\n"
+            "  --book ARQUIVO  livro de aberturas (opcional)\n"
+            "  --endgame ARQUIVO  banco de finais (opcional)\n",
+            program);
+}
+
+int main(int argc, char* argv[]) {
+    static Analyzer analyzer;
+    analyzer.limits = (SearchLimits){.maxDepth = 12, .threads = 1};
+    analyzer.chunkLines = 256;
+    int workers = 4;
+    size_t hashMegabytes = 256;
+    const char* bookPath = nullptr;
+    const char* endgamePath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "--depth") == 0) {
+            analyzer.limits.maxDepth = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--time") == 0) {
+            analyzer.limits.timeLimitMs = (uint32_t)atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--nodes") == 0) {
+            analyzer.limits.nodeLimit = strtoull(argv[++i], nullptr, 10);
+        } else if (i + 1 < argc && strcmp(argv[i], "--workers") == 0) {
+            workers = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--chunk") == 0) {
+            analyzer.chunkLines = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--hash") == 0) {
+            hashMegabytes = (size_t)atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--book") == 0) {
+            bookPath = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--endgame") == 0) {
+            endgamePath = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (workers < 1 || workers > ANALYZE_MAX_WORKERS || analyzer.chunkLines < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (!engineInit(&analyzer.engine, hashMegabytes)) {
+        fprintf(stderr, "Erro ao alocar a tabela de transposição (%zu MB)\n", hashMegabytes);
+        return 1;
+    }
+    OpeningBook book;
+    if (bookPath) {
+        if (!bookOpen(&book, bookPath)) {
+            fprintf(stderr, "Erro ao abrir o livro de aberturas %s\n", bookPath);
+            return 1;
+        }
+        analyzer.engine.book = &book;
+    }
+    EndgameTable endgame;
+    if (endgamePath) {
+        if (!endgameOpen(&endgame, endgamePath)) {
+            fprintf(stderr, "Erro ao abrir o banco de finais %s\n", endgamePath);
+            return 1;
+        }
+        analyzer.engine.endgame = &endgame;
+    }
+
+    // Dois blocos por thread de busca mantêm todas ocupadas enquanto a leitura e a escrita andam
+    analyzer.slots = 2 * workers + 2;
+    analyzer.chunks = calloc((size_t)analyzer.slots, sizeof(Chunk));
+    if (!analyzer.chunks) {
+        fprintf(stderr, "Memória insuficiente\n");
+        return 1;
+    }
+    for (int i = 0; i < analyzer.slots; ++i) {
+        Chunk* chunk = &analyzer.chunks[i];
+        chunk->moves = malloc((size_t)analyzer.chunkLines * sizeof(*chunk->moves));
+        chunk->positions = malloc((size_t)analyzer.chunkLines * sizeof(Position));
+        chunk->valid = malloc((size_t)analyzer.chunkLines * sizeof(bool));
+        chunk->output = malloc((size_t)analyzer.chunkLines * ANALYZE_OUTPUT_LINE);
+        if (!chunk->moves || !chunk->positions || !chunk->valid || !chunk->output) {
+            fprintf(stderr, "Memória insuficiente\n");
+            return 1;
+        }
+    }
+    mtx_init(&analyzer.lock, mtx_plain);
+    cnd_init(&analyzer.chunkFree);
+    cnd_init(&analyzer.chunkParsed);
+    cnd_init(&analyzer.chunkSolved);
+
+    thrd_t threads[ANALYZE_MAX_WORKERS];
+    thrd_t writer;
+    for (int i = 0; i < workers; ++i) {
+        if (thrd_create(&threads[i], workerMain, &analyzer) != thrd_success) {
+            fprintf(stderr, "Erro ao criar a thread %d\n", i);
+            return 1;
+        }
+    }
+    if (thrd_create(&writer, writerMain, &analyzer) != thrd_success) {
+        fprintf(stderr, "Erro ao criar a thread de escrita\n");
+        return 1;
+    }
+
+    // Leitura: preenche o próximo bloco do anel assim que a escrita o libera
+    uint64_t start = clockNowUs();
+    bool more = true;
+    for (uint64_t sequence = 0; more; ++sequence) {
+        Chunk* chunk = &analyzer.chunks[sequence % (uint64_t)analyzer.slots];
+        mtx_lock(&analyzer.lock);
+        while (chunk->state != CHUNK_FREE) {
+            cnd_wait(&analyzer.chunkFree, &analyzer.lock);
+        }
+        mtx_unlock(&analyzer.lock);
+
+        chunk->count = 0;
+        while (chunk->count < analyzer.chunkLines) {
+            bool tooLong;
+            if (!readLine(chunk->moves[chunk->count], &tooLong)) {
+                more = false;
+                break;
+            }
+            Position* pos = &chunk->positions[chunk->count];
+            chunk->valid[chunk->count] = !tooLong && positionFromMoves(pos, chunk->moves[chunk->count]) >= 0 &&
+                                         !positionIsFull(pos);
+            chunk->count++;
+        }
+
+        mtx_lock(&analyzer.lock);
+        if (chunk->count > 0) {
+            chunk->state = CHUNK_PARSED;
+            analyzer.readChunks++;
+            cnd_signal(&analyzer.chunkParsed);
+        }
+        if (!more) {
+            analyzer.endOfInput = true;
+            cnd_broadcast(&analyzer.chunkParsed);
+            cnd_broadcast(&analyzer.chunkSolved);
+        }
+        mtx_unlock(&analyzer.lock);
+    }
+
+    for (int i = 0; i < workers; ++i) {
+        thrd_join(threads[i], nullptr);
+    }
+    thrd_join(writer, nullptr);
+    double seconds = (clockNowUs() - start) / 1e6;
+    fprintf(stderr, "Posições: %llu em %.2f s (%.0f por segundo, %d threads), inválidas: %llu\n",
+            (unsigned long long)analyzer.positions, seconds, seconds > 0 ? analyzer.positions / seconds : 0.0,
+            workers, (unsigned long long)analyzer.errors);
+
+    for (int i = 0; i < analyzer.slots; ++i) {
+        free(analyzer.chunks[i].moves);
+        free(analyzer.chunks[i].positions);
+        free(analyzer.chunks[i].valid);
+        free(analyzer.chunks[i].output);
+    }
+    free(analyzer.chunks);
+    engineFree(&analyzer.engine);
+    if (bookPath) {
+        bookClose(&book);
+    }
+    if (endgamePath) {
+        endgameClose(&endgame);
+    }
+    return 0;
+}
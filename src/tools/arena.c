@@ -0,0 +1,319 @@
+// Arena sem interface gráfica: joga muitas partidas motor contra motor, contra o motor MCTS ou contra a
+// heurística original, em paralelo, e mostra o placar, o tempo médio por jogada e os nós (ou playouts) por segundo.
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+#include "clock.h"
+#include "gamelog.h"
+#include "mcts.h"
+#include "random.h"
+#include "search.h"
+
+#define MCTS_MEGABYTES 64 // Arena de nós do MCTS de cada partida simultânea
+
+typedef enum {
+    OPPONENT_HEURISTIC,
+    OPPONENT_ENGINE,
+    OPPONENT_MCTS
+} Opponent;
+
+typedef struct {
+    int games;
+    int workers;
+    int randomPlies;       // Jogadas aleatórias no início de cada partida, para variar as aberturas
+    uint64_t seed;
+    size_t hashMegabytes;
+    Opponent opponent;
+    SearchLimits limitsA;  // Motor avaliado
+    SearchLimits limitsB;  // Adversário, quando é o motor ou o MCTS
+    GameLogWriter* log;    // Registro das partidas (opcional)
+} ArenaConfig;
+
+// Estatísticas de um lado da arena.
+typedef struct {
+    uint64_t moves;
+    uint64_t nodes;
+    uint64_t playouts;
+    uint64_t elapsedUs;
+} SideStats;
+
+typedef struct {
+    int wins;              // Vitórias do motor A
+    int draws;
+    int losses;
+    SideStats sides[2];
+} ArenaTotals;
+
+typedef struct {
+    const ArenaConfig* config;
+    atomic_int* nextGame;
+    ArenaTotals totals;
+} Worker;
+
+// Função para sortear uma jogada da abertura entre as que não vencem na hora (uma vitória sorteada seria
+// creditada a um dos motores); devolve false se só restarem jogadas vencedoras.
+static bool randomMove(const Position* pos, uint64_t* rng, int* col) {
+    int choices[COLS];
+    int count = 0;
+    for (int c = 0; c < COLS; ++c) {
+        if (positionCanPlay(pos, c) && !positionWinsWith(pos, c, positionPlayerToMove(pos))) {
+            choices[count++] = c;
+        }
+    }
+    if (count == 0) {
+        return false;
+    }
+    *col = choices[nextRandom(rng) % (uint64_t)count];
+    return true;
+}
+
+// Função para jogar uma partida; devolve o vencedor do ponto de vista do motor A (1, 0 ou -1).
+static int playGame(const ArenaConfig* config, Engine engines[2], Mcts* tree, int gameIndex, ArenaTotals* totals) {
+    // Cada partida tem sua própria semente, então os resultados são reproduzíveis
+    uint64_t rng = config->seed + (uint64_t)gameIndex * 0x9E3779B97F4A7C15u + 1;
+    int sideA = gameIndex % 2;   // Em partidas ímpares o motor A joga em segundo
+    Position pos;
+    positionInit(&pos);
+    GameRecord record = {
+        .cols = COLS,
+        .rows = ROWS,
+        .outcome = OUTCOME_DRAW,
+        .vsComputer = true,
+        .aiThreads = config->limitsA.threads,
+        .aiTimeLimitMs = config->limitsA.timeLimitMs,
+        .startTime = (uint64_t)time(nullptr),
+    };
+    int outcome = 0;
+
+    while (!positionIsFull(&pos)) {
+        int side = pos.moves % 2 == sideA ? 0 : 1;
+        int col;
+        if (pos.moves < config->randomPlies && randomMove(&pos, &rng, &col)) {
+            // Jogada sorteada da abertura: não entra nas estatísticas dos lados
+        } else if (side == 1 && config->opponent == OPPONENT_HEURISTIC) {
+            col = searchHeuristicMove(&pos);
+        } else {
+            const SearchLimits* limits = side == 0 ? &config->limitsA : &config->limitsB;
+            SearchResult result = side == 1 && config->opponent == OPPONENT_MCTS
+                                      ? mctsBestMove(tree, &pos, limits)
+                                      : searchBestMove(&engines[side], &pos, limits);
+            col = result.bestCol;
+            totals->sides[side].moves++;
+            totals->sides[side].nodes += result.nodes;
+            totals->sides[side].playouts += result.playouts;
+            totals->sides[side].elapsedUs += result.elapsedUs;
+        }
+
+        Player player = positionPlayerToMove(&pos);
+        bool won = positionWinsWith(&pos, col, player);
+        record.moves[record.moveCount++] = (uint8_t)col;
+        positionPlay(&pos, col);
+        if (won) {
+            record.outcome = player == PLAYER1 ? OUTCOME_PLAYER1 : OUTCOME_PLAYER2;
+            outcome = side == 0 ? 1 : -1;
+            break;
+        }
+    }
+
+    if (config->log) {
+        record.durationSeconds = (uint32_t)((uint64_t)time(nullptr) - record.startTime);
+        gameLogWrite(config->log, &record);
+    }
+    return outcome;
+}
+
+static int workerMain(void* arg) {
+    Worker* worker = arg;
+    const ArenaConfig* config = worker->config;
+    Engine engines[2];
+    if (!engineInit(&engines[0], config->hashMegabytes) || !engineInit(&engines[1], config->hashMegabytes)) {
+        fprintf(stderr, "Erro ao alocar a tabela de transposição (%zu MB)\n", config->hashMegabytes);
+        return 1;
+    }
+    Mcts tree = {0};
+    if (config->opponent == OPPONENT_MCTS && !mctsInit(&tree, MCTS_MEGABYTES)) {
+        fprintf(stderr, "Erro ao alocar a árvore do MCTS (%d MB)\n", MCTS_MEGABYTES);
+        return 1;
+    }
+
+    for (;;) {
+        int game = atomic_fetch_add(worker->nextGame, 1);
+        if (game >= config->games) {
+            break;
+        }
+        int outcome = playGame(config, engines, &tree, game, &worker->totals);
+        if (outcome > 0) {
+            worker->totals.wins++;
+        } else if (outcome < 0) {
+            worker->totals.losses++;
+        } else {
+            worker->totals.draws++;
+        }
+    }
+
+    engineFree(&engines[0]);
+    engineFree(&engines[1]);
+    mctsFree(&tree);
+    return 0;
+}
+
+static void printSide(const char* name, const SideStats* stats) {
+    if (stats->moves == 0) {
+        return;
+    }
+    double seconds = stats->elapsedUs / 1e6;
+    if (stats->playouts) {
+        printf("%s: %llu jogadas, %.2f ms por jogada, %.0f playouts/s\n", name, (unsigned long long)stats->moves,
+               stats->elapsedUs / 1000.0 / stats->moves, seconds > 0 ? stats->playouts / seconds : 0.0);
+        return;
+    }
+    printf("%s: %llu jogadas, %.2f ms por jogada, %.0f nós/s\n", name, (unsigned long long)stats->moves,
+           stats->elapsedUs / 1000.0 / stats->moves, seconds > 0 ? stats->nodes / seconds : 0.0);
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Uso: %s [opções]\n"
+            "  --games N        número de partidas (padrão 100)\n"
+            "  --workers W      partidas simultâneas (padrão 4)\n"
+            "  --opponent TIPO  heuristic, engine ou mcts (padrão heuristic)\n"
+            "  --time MS        tempo por jogada do motor A (padrão 50)\n"
+            "  --depth D        profundidade máxima do motor A (padrão 0 = sem limite)\n"
+            "  --threads T      threads de busca do motor A (padrão 1)\n"
+            "  --time-b MS      tempo por jogada do motor B (padrão igual ao de A)\n"
+            "  --depth-b D      profundidade máxima do motor B (padrão igual à de A)\n"
+            "  --threads-b T    threads de busca do motor B (padrão 1)\n"
+            "  --random-plies K jogadas aleatórias no início (padrão 2)\n"
+            "  --seed S         semente das aberturas aleatórias (padrão 1)\n"
+            "  --hash MB        tabela de transposição de cada motor (padrão 16)\n"
+            "  --log ARQUIVO    acrescenta as partidas a um registro (ver c4replay)\n",
+            program);
+}
+
+int main(int argc, char* argv[]) {
+    ArenaConfig config = {
+        .games = 100,
+        .workers = 4,
+        .randomPlies = 2,
+        .seed = 1,
+        .hashMegabytes = 16,
+        .opponent = OPPONENT_HEURISTIC,
+        .limitsA = {.timeLimitMs = 50, .threads = 1},
+    };
+    int timeB = -1;
+    int depthB = -1;
+    int threadsB = 1;
+    const char* logPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "--games") == 0) {
+            config.games = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--workers") == 0) {
+            config.workers = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--opponent") == 0) {
+            const char* name = argv[++i];
+            if (strcmp(name, "heuristic") == 0) {
+                config.opponent = OPPONENT_HEURISTIC;
+            } else if (strcmp(name, "engine") == 0) {
+                config.opponent = OPPONENT_ENGINE;
+            } else if (strcmp(name, "mcts") == 0) {
+                config.opponent = OPPONENT_MCTS;
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (i + 1 < argc && strcmp(argv[i], "--time") == 0) {
+            config.limitsA.timeLimitMs = (uint32_t)atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--depth") == 0) {
+            config.limitsA.maxDepth = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--threads") == 0) {
+            config.limitsA.threads = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--time-b") == 0) {
+            timeB = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--depth-b") == 0) {
+            depthB = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--threads-b") == 0) {
+            threadsB = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--random-plies") == 0) {
+            config.randomPlies = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--seed") == 0) {
+            config.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (i + 1 < argc && strcmp(argv[i], "--hash") == 0) {
+            config.hashMegabytes = (size_t)atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--log") == 0) {
+            logPath = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    config.limitsB = config.limitsA;
+    if (timeB >= 0) {
+        config.limitsB.timeLimitMs = (uint32_t)timeB;
+    }
+    if (depthB >= 0) {
+        config.limitsB.maxDepth = depthB;
+    }
+    config.limitsB.threads = threadsB;
+    if (config.workers < 1) {
+        config.workers = 1;
+    }
+    GameLogWriter log = {0};
+    if (logPath) {
+        if (!gameLogWriterOpen(&log, logPath)) {
+            fprintf(stderr, "Erro ao abrir o registro %s\n", logPath);
+            return 1;
+        }
+        config.log = &log;
+    }
+
+    Worker* workers = calloc((size_t)config.workers, sizeof(Worker));
+    thrd_t* threads = calloc((size_t)config.workers, sizeof(thrd_t));
+    if (!workers || !threads) {
+        fprintf(stderr, "Memória insuficiente\n");
+        return 1;
+    }
+    atomic_int nextGame = 0;
+    uint64_t start = clockNowUs();
+    for (int i = 0; i < config.workers; ++i) {
+        workers[i] = (Worker){.config = &config, .nextGame = &nextGame};
+        if (thrd_create(&threads[i], workerMain, &workers[i]) != thrd_success) {
+            fprintf(stderr, "Erro ao criar a thread %d\n", i);
+            return 1;
+        }
+    }
+
+    ArenaTotals totals = {0};
+    int failed = 0;
+    for (int i = 0; i < config.workers; ++i) {
+        int status;
+        thrd_join(threads[i], &status);
+        failed |= status;
+        totals.wins += workers[i].totals.wins;
+        totals.draws += workers[i].totals.draws;
+        totals.losses += workers[i].totals.losses;
+        for (int side = 0; side < 2; ++side) {
+            totals.sides[side].moves += workers[i].totals.sides[side].moves;
+            totals.sides[side].nodes += workers[i].totals.sides[side].nodes;
+            totals.sides[side].playouts += workers[i].totals.sides[side].playouts;
+            totals.sides[side].elapsedUs += workers[i].totals.sides[side].elapsedUs;
+        }
+    }
+    double wallSeconds = (clockNowUs() - start) / 1e6;
+
+    int played = totals.wins + totals.draws + totals.losses;
+    printf("Partidas: %d em %.2f s (%d simultâneas)\n", played, wallSeconds, config.workers);
+    printf("Motor A contra %s: %d vitórias, %d empates, %d derrotas\n",
+           config.opponent == OPPONENT_HEURISTIC ? "heurística" : config.opponent == OPPONENT_MCTS ? "MCTS" : "motor B",
+           totals.wins, totals.draws, totals.losses);
+    printSide("Motor A", &totals.sides[0]);
+    printSide("Motor B", &totals.sides[1]);
+
+    gameLogWriterClose(&log);
+    free(workers);
+    free(threads);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,241 @@
+// Benchmark do motor: resolve conjuntos de posições de teste (abertura, meio-jogo, final) e mostra, por
+// conjunto, tempo, nós, nós por segundo e taxa de acerto da tabela de transposição.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "search.h"
+
+#define MAX_SETS 16
+#define MAX_LINE 256
+
+typedef enum {
+    FORMAT_TEXT,
+    FORMAT_CSV,
+    FORMAT_JSON
+} Format;
+
+typedef struct {
+    char name[32];
+    SearchLimits limits;
+    int positions;
+    int solved;
+    uint64_t nodes;
+    uint64_t elapsedUs;
+    uint64_t depthSum;
+    TTStats tt;
+} BenchSet;
+
+typedef struct {
+    char name[32];
+    double timeMs;
+    double nodesPerSec;
+} Baseline;
+
+static double nodesPerSec(const BenchSet* set) {
+    return set->elapsedUs ? set->nodes * 1e6 / set->elapsedUs : 0.0;
+}
+
+static double hitRate(const BenchSet* set) {
+    return set->tt.probes ? (double)set->tt.hits / set->tt.probes : 0.0;
+}
+
+// Função para ler o cabeçalho de um conjunto: "[nome opção=valor ...]".
+static bool parseSetHeader(char* line, BenchSet* set, const SearchLimits* defaults) {
+    char* end = strchr(line, ']');
+    if (!end) {
+        return false;
+    }
+    *end = '\0';
+    *set = (BenchSet){.limits = *defaults};
+    char* token = strtok(line + 1, " \t");
+    if (!token) {
+        return false;
+    }
+    snprintf(set->name, sizeof(set->name), "%s", token);
+    while ((token = strtok(nullptr, " \t"))) {
+        if (strncmp(token, "depth=", 6) == 0) {
+            set->limits.maxDepth = atoi(token + 6);
+        } else if (strncmp(token, "time=", 5) == 0) {
+            set->limits.timeLimitMs = (uint32_t)atoi(token + 5);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Função para carregar um arquivo de referência gerado com --format csv.
+static int loadBaseline(const char* path, Baseline* baseline) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return -1;
+    }
+    char line[MAX_LINE];
+    int count = 0;
+    while (count < MAX_SETS && fgets(line, sizeof(line), file)) {
+        char name[32];
+        int positions, solved;
+        unsigned long long nodes;
+        double timeMs, nps;
+        if (sscanf(line, "%31[^,],%d,%d,%llu,%lf,%lf", name, &positions, &solved, &nodes, &timeMs, &nps) == 6) {
+            snprintf(baseline[count].name, sizeof(baseline[count].name), "%s", name);
+            baseline[count].timeMs = timeMs;
+            baseline[count].nodesPerSec = nps;
+            count++;
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+static void printResults(const BenchSet* sets, int count, Format format) {
+    if (format == FORMAT_CSV) {
+        printf("set,positions,solved,nodes,time_ms,nodes_per_sec,tt_hit_rate,avg_depth\n");
+    } else if (format == FORMAT_JSON) {
+        printf("[\n");
+    } else {
+        printf("%-12s %9s %7s %14s %11s %13s %8s %9s\n", "conjunto", "posições", "exatas", "nós", "tempo (ms)",
+               "nós/s", "acertos", "prof. média");
+    }
+
+    for (int i = 0; i < count; ++i) {
+        const BenchSet* set = &sets[i];
+        double avgDepth = set->positions ? (double)set->depthSum / set->positions : 0.0;
+        if (format == FORMAT_CSV) {
+            printf("%s,%d,%d,%llu,%.3f,%.0f,%.4f,%.2f\n", set->name, set->positions, set->solved,
+                   (unsigned long long)set->nodes, set->elapsedUs / 1000.0, nodesPerSec(set), hitRate(set), avgDepth);
+        } else if (format == FORMAT_JSON) {
+            printf("  {\"set\": \"%s\", \"positions\": %d, \"solved\": %d, \"nodes\": %llu, \"time_ms\": %.3f, "
+                   "\"nodes_per_sec\": %.0f, \"tt_hit_rate\": %.4f, \"avg_depth\": %.2f}%s\n",
+                   set->name, set->positions, set->solved, (unsigned long long)set->nodes, set->elapsedUs / 1000.0,
+                   nodesPerSec(set), hitRate(set), avgDepth, i + 1 < count ? "," : "");
+        } else {
+            printf("%-12s %9d %7d %14llu %11.1f %13.0f %7.1f%% %9.2f\n", set->name, set->positions, set->solved,
+                   (unsigned long long)set->nodes, set->elapsedUs / 1000.0, nodesPerSec(set), hitRate(set) * 100,
+                   avgDepth);
+        }
+    }
+
+    if (format == FORMAT_JSON) {
+        printf("]\n");
+    }
+}
+
+static void printComparison(const BenchSet* sets, int count, const Baseline* baseline, int baselineCount) {
+    printf("\nComparação com a referência (tempo / nós/s em relação à referência):\n");
+    for (int i = 0; i < count; ++i) {
+        for (int j = 0; j < baselineCount; ++j) {
+            if (strcmp(sets[i].name, baseline[j].name) == 0 && baseline[j].timeMs > 0 && baseline[j].nodesPerSec > 0) {
+                printf("%-12s tempo %6.2fx   nós/s %6.2fx\n", sets[i].name,
+                       sets[i].elapsedUs / 1000.0 / baseline[j].timeMs, nodesPerSec(&sets[i]) / baseline[j].nodesPerSec);
+            }
+        }
+    }
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Uso: %s [ARQUIVO] [opções]\n"
+            "  ARQUIVO          posições de teste (padrão bench/positions.txt)\n"
+            "  --format F       text, csv ou json (padrão text)\n"
+            "  --threads T      threads de busca (padrão 1)\n"
+            "  --hash MB        tabela de transposição (padrão 64)\n"
+            "  --baseline CSV   compara com um resultado anterior gravado com --format csv\n",
+            program);
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = "bench/positions.txt";
+    const char* baselinePath = nullptr;
+    Format format = FORMAT_TEXT;
+    SearchLimits defaults = {.threads = 1};
+    size_t hashMegabytes = 64;
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "--format") == 0) {
+            const char* name = argv[++i];
+            if (strcmp(name, "text") == 0) {
+                format = FORMAT_TEXT;
+            } else if (strcmp(name, "csv") == 0) {
+                format = FORMAT_CSV;
+            } else if (strcmp(name, "json") == 0) {
+                format = FORMAT_JSON;
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (i + 1 < argc && strcmp(argv[i], "--threads") == 0) {
+            defaults.threads = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--hash") == 0) {
+            hashMegabytes = (size_t)atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--baseline") == 0) {
+            baselinePath = argv[++i];
+        } else if (argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Erro ao abrir %s\n", path);
+        return 1;
+    }
+    Engine engine;
+    if (!engineInit(&engine, hashMegabytes)) {
+        fprintf(stderr, "Erro ao alocar a tabela de transposição (%zu MB)\n", hashMegabytes);
+        return 1;
+    }
+
+    BenchSet sets[MAX_SETS];
+    int setCount = 0;
+    char line[MAX_LINE];
+    int lineNumber = 0;
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#') {
+            continue;
+        }
+        if (line[0] == '[') {
+            if (setCount == MAX_SETS || !parseSetHeader(line, &sets[setCount], &defaults)) {
+                fprintf(stderr, "%s:%d: conjunto inválido\n", path, lineNumber);
+                return 1;
+            }
+            setCount++;
+            continue;
+        }
+        Position pos;
+        if (setCount == 0 || positionFromMoves(&pos, strcmp(line, "-") == 0 ? "" : line) < 0) {
+            fprintf(stderr, "%s:%d: posição inválida: %s\n", path, lineNumber, line);
+            return 1;
+        }
+
+        // Cada posição começa com a tabela vazia, para os números não dependerem da ordem do arquivo
+        ttClear(&engine.tt);
+        BenchSet* set = &sets[setCount - 1];
+        SearchResult result = searchBestMove(&engine, &pos, &set->limits);
+        set->positions++;
+        set->solved += result.solved;
+        set->nodes += result.nodes;
+        set->elapsedUs += result.elapsedUs;
+        set->depthSum += (uint64_t)result.depth;
+        ttStatsAdd(&set->tt, &result.tt);
+    }
+    fclose(file);
+    engineFree(&engine);
+
+    printResults(sets, setCount, format);
+    if (baselinePath) {
+        Baseline baseline[MAX_SETS];
+        int baselineCount = loadBaseline(baselinePath, baseline);
+        if (baselineCount < 0) {
+            fprintf(stderr, "Erro ao abrir %s\n", baselinePath);
+            return 1;
+        }
+        printComparison(sets, setCount, baseline, baselineCount);
+    }
+    return 0;
+}
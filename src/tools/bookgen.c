@@ -0,0 +1,173 @@
+// Gerador do livro de aberturas: enumera todas as posições até um número de jogadas, resolve cada uma
+// com o motor de busca e grava o resultado em um arquivo binário ordenado (ver book.h).
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "book.h"
+#include "search.h"
+
+typedef struct {
+    uint64_t* slots;       // Chave + 1 (0 = vazio)
+    size_t capacity;
+    size_t count;
+} KeySet;
+
+typedef struct {
+    Position* items;
+    size_t count;
+    size_t capacity;
+} PositionList;
+
+// Função para inserir uma chave no conjunto; devolve false se ela já estava lá.
+static bool keySetInsert(KeySet* set, uint64_t key) {
+    if ((set->count + 1) * 2 > set->capacity) {
+        KeySet grown = {.capacity = set->capacity ? set->capacity * 2 : 1024};
+        grown.slots = calloc(grown.capacity, sizeof(uint64_t));
+        if (!grown.slots) {
+            fprintf(stderr, "Memória insuficiente\n");
+            exit(1);
+        }
+        for (size_t i = 0; i < set->capacity; ++i) {
+            if (set->slots[i]) {
+                keySetInsert(&grown, set->slots[i] - 1);
+            }
+        }
+        free(set->slots);
+        *set = grown;
+    }
+    size_t i = (key * 0x9E3779B97F4A7C15u) & (set->capacity - 1);
+    while (set->slots[i]) {
+        if (set->slots[i] == key + 1) {
+            return false;
+        }
+        i = (i + 1) & (set->capacity - 1);
+    }
+    set->slots[i] = key + 1;
+    set->count++;
+    return true;
+}
+
+static void positionListPush(PositionList* list, const Position* pos) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 1024;
+        list->items = realloc(list->items, list->capacity * sizeof(Position));
+        if (!list->items) {
+            fprintf(stderr, "Memória insuficiente\n");
+            exit(1);
+        }
+    }
+    list->items[list->count++] = *pos;
+}
+
+// Enumera as posições ainda em jogo com até maxMoves jogadas, uma vez por classe de simetria.
+static void enumerate(const Position* pos, int maxMoves, KeySet* seen, PositionList* list) {
+    bool mirrored;
+    if (!keySetInsert(seen, bookCanonicalKey(pos, &mirrored))) {
+        return;
+    }
+    positionListPush(list, pos);
+    if (pos->moves == maxMoves) {
+        return;
+    }
+    for (int col = 0; col < COLS; ++col) {
+        if (positionCanPlay(pos, col) && !positionWinsWith(pos, col, positionPlayerToMove(pos))) {
+            Position child = *pos;
+            positionPlay(&child, col);
+            enumerate(&child, maxMoves, seen, list);
+        }
+    }
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Uso: %s [--plies N] [--time MS] [--depth D] [--threads T] [--hash MB] [--out ARQUIVO]\n"
+            "  --plies N    número máximo de jogadas das posições do livro (padrão 8)\n"
+            "  --time MS    tempo de busca por posição (padrão 0 = sem limite, até resolver)\n"
+            "  --depth D    profundidade máxima de busca (padrão 0 = até o fim do jogo)\n"
+            "  --threads T  threads de busca (padrão 1)\n"
+            "  --hash MB    tamanho da tabela de transposição (padrão 256)\n"
+            "  --out ARQ    arquivo de saída (padrão opening.book)\n",
+            program);
+}
+
+int main(int argc, char* argv[]) {
+    int plies = 8;
+    // Sem limites, cada posição é resolvida; entradas não resolvidas são gravadas, mas o jogo as ignora
+    SearchLimits limits = {.threads = 1};
+    size_t hashMegabytes = 256;
+    const char* outPath = "opening.book";
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "--plies") == 0) {
+            plies = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--time") == 0) {
+            limits.timeLimitMs = (uint32_t)atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--depth") == 0) {
+            limits.maxDepth = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--threads") == 0) {
+            limits.threads = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--hash") == 0) {
+            hashMegabytes = (size_t)atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--out") == 0) {
+            outPath = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (plies < 0 || plies >= ROWS * COLS) {
+        fprintf(stderr, "Número de jogadas inválido: %d\n", plies);
+        return 1;
+    }
+
+    Engine engine;
+    if (!engineInit(&engine, hashMegabytes)) {
+        fprintf(stderr, "Erro ao alocar a tabela de transposição (%zu MB)\n", hashMegabytes);
+        return 1;
+    }
+
+    KeySet seen = {0};
+    PositionList list = {0};
+    Position root;
+    positionInit(&root);
+    enumerate(&root, plies, &seen, &list);
+    free(seen.slots);
+    fprintf(stderr, "%zu posições até %d jogadas\n", list.count, plies);
+
+    BookRecord* records = malloc(list.count * sizeof(BookRecord));
+    if (!records) {
+        fprintf(stderr, "Memória insuficiente\n");
+        return 1;
+    }
+    size_t solved = 0;
+    for (size_t i = 0; i < list.count; ++i) {
+        SearchResult result = searchBestMove(&engine, &list.items[i], &limits);
+        bool mirrored;
+        records[i].key = bookCanonicalKey(&list.items[i], &mirrored);
+        BookMove move = {
+            .col = mirrored ? COLS - 1 - result.bestCol : result.bestCol,
+            .score = result.score,
+            .depth = result.depth,
+            .solved = result.solved,
+        };
+        records[i].value = bookPackValue(&move);
+        solved += result.solved;
+        if ((i + 1) % 1000 == 0 || i + 1 == list.count) {
+            fprintf(stderr, "\r%zu/%zu posições (%zu exatas)", i + 1, list.count, solved);
+        }
+    }
+    fprintf(stderr, "\n");
+    if (solved < list.count) {
+        fprintf(stderr, "Aviso: %zu posições não foram resolvidas e não serão usadas pela busca\n",
+                list.count - solved);
+    }
+
+    bool ok = bookWrite(outPath, records, list.count, plies);
+    if (!ok) {
+        fprintf(stderr, "Erro ao gravar %s\n", outPath);
+    }
+    free(records);
+    free(list.items);
+    engineFree(&engine);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,264 @@
+// Gerador do banco de finais: a partir de posições-semente com N + K casas vazias, enumera todas as posições
+// alcançáveis abaixo delas e guarda as que têm até N casas vazias, resolve cada uma com exatidão (minimax completo, reaproveitando os valores já
+// calculados das posições repetidas) e grava o resultado em uma tabela de espalhamento (ver endgame.h).
+// As sementes vêm de registros de partidas (c4replay, c4arena --log) e de partidas aleatórias: enumerar
+// todas as posições com N casas vazias do tabuleiro inteiro é inviável a partir de N pequeno.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "book.h"
+#include "clock.h"
+#include "endgame.h"
+#include "gamelog.h"
+#include "random.h"
+#include "search.h"
+
+#define MAX_LOGS 16
+
+// Posições já resolvidas: chave canônica (0 = vazio) e valor empacotado.
+typedef struct {
+    uint64_t* keys;
+    int8_t* values;
+    size_t capacity;
+    size_t count;
+    int minMoves;          // Posições com menos jogadas são percorridas, mas não guardadas
+} SolvedTable;
+
+
+static int8_t* solvedFind(SolvedTable* table, uint64_t key, bool* found) {
+    size_t i = endgameSlot(key, table->capacity);
+    while (table->keys[i] && table->keys[i] != key) {
+        i = (i + 1) & (table->capacity - 1);
+    }
+    *found = table->keys[i] == key;
+    if (!*found) {
+        table->keys[i] = key;
+    }
+    return &table->values[i];
+}
+
+static void solvedGrow(SolvedTable* table) {
+    SolvedTable grown = {.capacity = table->capacity ? table->capacity * 2 : 1 << 16, .minMoves = table->minMoves};
+    grown.keys = calloc(grown.capacity, sizeof(uint64_t));
+    grown.values = calloc(grown.capacity, sizeof(int8_t));
+    if (!grown.keys || !grown.values) {
+        fprintf(stderr, "Memória insuficiente\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < table->capacity; ++i) {
+        if (table->keys[i]) {
+            bool found;
+            *solvedFind(&grown, table->keys[i], &found) = table->values[i];
+        }
+    }
+    grown.count = table->count;
+    free(table->keys);
+    free(table->values);
+    *table = grown;
+}
+
+// Função para resolver uma posição e todas as que estão abaixo dela; devolve o valor exato do ponto de
+// vista do jogador da vez. Só as posições sem vitória imediata e dentro do alcance do banco entram na tabela.
+static int solve(SolvedTable* table, const Position* pos) {
+    for (int col = 0; col < COLS; ++col) {
+        if (positionCanPlay(pos, col) && positionWinsWith(pos, col, positionPlayerToMove(pos))) {
+            return SCORE_WIN - (pos->moves + 1);
+        }
+    }
+    if (pos->moves >= ROWS * COLS - 1) {
+        return 0;
+    }
+    if (pos->moves < table->minMoves) {
+        int best = -SCORE_INFINITY;
+        for (int col = 0; col < COLS; ++col) {
+            if (positionCanPlay(pos, col)) {
+                Position child = *pos;
+                positionPlay(&child, col);
+                int score = -solve(table, &child);
+                if (score > best) {
+                    best = score;
+                }
+            }
+        }
+        return best;
+    }
+
+    if ((table->count + 1) * 2 > table->capacity) {
+        solvedGrow(table);
+    }
+    bool mirrored;
+    uint64_t key = bookCanonicalKey(pos, &mirrored);
+    bool found;
+    int8_t* value = solvedFind(table, key, &found);
+    if (found) {
+        int packed = *value;
+        return packed > 0 ? SCORE_WIN - packed : packed < 0 ? -(SCORE_WIN + packed) : 0;
+    }
+    // A entrada fica reservada (valor 0) enquanto os filhos são resolvidos; eles têm mais peças e nunca
+    // voltam a esta posição
+    table->count++;
+
+    int best = -SCORE_INFINITY;
+    for (int col = 0; col < COLS; ++col) {
+        if (positionCanPlay(pos, col)) {
+            Position child = *pos;
+            positionPlay(&child, col);
+            int score = -solve(table, &child);
+            if (score > best) {
+                best = score;
+            }
+        }
+    }
+    // A tabela pode ter crescido durante a recursão: procura a entrada de novo
+    *solvedFind(table, key, &found) = endgamePackScore(best);
+    return best;
+}
+
+// Função para jogar uma partida aleatória até restarem maxEmpty casas, evitando as jogadas que vencem (senão
+// quase nenhuma partida chegaria ao fim); devolve false se só restarem jogadas vencedoras antes disso.
+static bool randomSeed(uint64_t* rng, int maxEmpty, Position* pos) {
+    positionInit(pos);
+    while (pos->moves < ROWS * COLS - maxEmpty) {
+        int choices[COLS];
+        int count = 0;
+        for (int col = 0; col < COLS; ++col) {
+            if (positionCanPlay(pos, col) && !positionWinsWith(pos, col, positionPlayerToMove(pos))) {
+                choices[count++] = col;
+            }
+        }
+        if (count == 0) {
+            return false;
+        }
+        positionPlay(pos, choices[nextRandom(rng) % (uint64_t)count]);
+    }
+    return true;
+}
+
+// Função para refazer uma partida registrada até restarem maxEmpty casas; devolve false se ela terminou antes.
+static bool logSeed(const GameRecord* record, int maxEmpty, Position* pos) {
+    if (record->cols != COLS || record->rows != ROWS) {
+        return false;
+    }
+    positionInit(pos);
+    for (int i = 0; i < record->moveCount && pos->moves < ROWS * COLS - maxEmpty; ++i) {
+        int col = record->moves[i];
+        if (!positionCanPlay(pos, col) || positionWinsWith(pos, col, positionPlayerToMove(pos))) {
+            return false;
+        }
+        positionPlay(pos, col);
+    }
+    return pos->moves == ROWS * COLS - maxEmpty;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Uso: %s [opções]\n"
+            "  --empty N       casas vazias das posições do banco (padrão 10)\n"
+            "  --spread K      as sementes param K jogadas antes, para cobrir também as posições vizinhas (padrão 2)\n"
+            "  --log ARQUIVO   sementes tiradas de um registro de partidas (pode repetir)\n"
+            "  --random G      sementes de G partidas aleatórias (padrão 1000)\n"
+            "  --seed S        semente do sorteio (padrão 1)\n"
+            "  --out ARQUIVO   arquivo de saída (padrão endgame.db)\n",
+            program);
+}
+
+int main(int argc, char* argv[]) {
+    int maxEmpty = 10;
+    int spread = 2;
+    int randomGames = 1000;
+    uint64_t rng = 1;
+    const char* outPath = "endgame.db";
+    const char* logPaths[MAX_LOGS];
+    int logCount = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "--empty") == 0) {
+            maxEmpty = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--spread") == 0) {
+            spread = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--log") == 0 && logCount < MAX_LOGS) {
+            logPaths[logCount++] = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--random") == 0) {
+            randomGames = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--seed") == 0) {
+            rng = strtoull(argv[++i], nullptr, 10);
+            if (rng == 0) {
+                rng = 0x9E3779B97F4A7C15u;  // O xorshift não sai do estado 0
+            }
+        } else if (i + 1 < argc && strcmp(argv[i], "--out") == 0) {
+            outPath = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (maxEmpty < 1 || spread < 0 || maxEmpty + spread >= ROWS * COLS || randomGames < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    SolvedTable table = {.minMoves = ROWS * COLS - maxEmpty};
+    solvedGrow(&table);
+    uint64_t start = clockNowUs();
+    int seeds = 0;
+
+    for (int i = 0; i < logCount; ++i) {
+        GameLogReader reader;
+        if (!gameLogReaderOpen(&reader, logPaths[i])) {
+            fprintf(stderr, "Erro ao abrir o registro %s\n", logPaths[i]);
+            return 1;
+        }
+        GameRecord record;
+        Position pos;
+        while (gameLogNext(&reader, &record)) {
+            if (logSeed(&record, maxEmpty + spread, &pos)) {
+                solve(&table, &pos);
+                seeds++;
+            }
+        }
+        gameLogReaderClose(&reader);
+    }
+    for (int i = 0; i < randomGames; ++i) {
+        Position pos;
+        if (randomSeed(&rng, maxEmpty + spread, &pos)) {
+            solve(&table, &pos);
+            seeds++;
+        }
+    }
+    double solveSeconds = (clockNowUs() - start) / 1e6;
+
+    // Compacta a tabela em listas de chaves e valores e conta os resultados
+    uint64_t* keys = malloc((table.count ? table.count : 1) * sizeof(uint64_t));
+    int8_t* values = malloc(table.count ? table.count : 1);
+    if (!keys || !values) {
+        fprintf(stderr, "Memória insuficiente\n");
+        return 1;
+    }
+    size_t count = 0;
+    size_t wins = 0;
+    size_t losses = 0;
+    for (size_t i = 0; i < table.capacity; ++i) {
+        if (table.keys[i]) {
+            keys[count] = table.keys[i];
+            values[count] = table.values[i];
+            wins += values[count] > 0;
+            losses += values[count] < 0;
+            count++;
+        }
+    }
+    free(table.keys);
+    free(table.values);
+
+    if (!endgameWrite(outPath, keys, values, count, maxEmpty)) {
+        fprintf(stderr, "Erro ao gravar %s\n", outPath);
+        return 1;
+    }
+    fprintf(stderr, "%d sementes com %d casas vazias: %zu posições com até %d resolvidas em %.2f s\n", seeds,
+            maxEmpty + spread, count, maxEmpty, solveSeconds);
+    fprintf(stderr, "Jogador da vez: %zu vitórias, %zu empates, %zu derrotas\n", wins, count - wins - losses,
+            losses);
+    fprintf(stderr, "Banco gravado em %s\n", outPath);
+    free(keys);
+    free(values);
+    return 0;
+}
@@ -0,0 +1,340 @@
+// Gerador de carga para o c4server: abre várias conexões, cada uma em sua thread, envia posições em lotes
+// (várias linhas por envio) e mede a latência de cada pedido. Mostra a vazão e os percentis de latência e,
+// no fim, os contadores do servidor (buscas feitas e pedidos agrupados com uma busca em andamento).
+#define _GNU_SOURCE
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <threads.h>
+#include <unistd.h>
+#include "clock.h"
+#include "position.h"
+#include "random.h"
+
+#define DEFAULT_PORT 4004
+#define LOAD_MAX_BATCH 256
+#define LOAD_MAX_LINE (ROWS * COLS + 2)
+
+typedef struct {
+    const char* unixPath;
+    int port;
+    int connections;
+    int requests;          // Pedidos por conexão
+    int batch;             // Pedidos por envio
+    int plies;             // Jogadas aleatórias de cada posição
+    int distinct;          // Posições diferentes sorteadas (0 = uma nova a cada pedido)
+    uint64_t seed;
+    char (*pool)[LOAD_MAX_LINE];
+} LoadConfig;
+
+typedef struct {
+    const LoadConfig* config;
+    int index;
+    uint64_t* latencies;   // Latência de cada pedido respondido, em microssegundos
+    int answered;
+    int errors;
+    bool failed;
+} Client;
+
+// Função para sortear uma posição com o número de jogadas pedido, sem vitória no caminho.
+static void randomPosition(uint64_t* rng, int plies, char* moves) {
+    for (;;) {
+        Position pos;
+        positionInit(&pos);
+        int length = 0;
+        int attempts = 0;
+        while (length < plies && attempts < 8 * COLS) {
+            int col = (int)(nextRandom(rng) % COLS);
+            attempts++;
+            if (!positionCanPlay(&pos, col) || positionWinsWith(&pos, col, positionPlayerToMove(&pos))) {
+                continue;
+            }
+            positionPlay(&pos, col);
+            moves[length++] = (char)('1' + col);
+            attempts = 0;
+        }
+        // Sem jogada que não vença na hora (ou com o tabuleiro cheio), recomeça o sorteio
+        if (length == plies) {
+            moves[length] = '\0';
+            return;
+        }
+    }
+}
+
+static int connectServer(const LoadConfig* config) {
+    int fd;
+    if (config->unixPath) {
+        struct sockaddr_un address = {.sun_family = AF_UNIX};
+        snprintf(address.sun_path, sizeof(address.sun_path), "%s", config->unixPath);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr*)&address, sizeof(address)) < 0) {
+            close(fd);
+            fd = -1;
+        }
+    } else {
+        struct sockaddr_in address = {
+            .sin_family = AF_INET,
+            .sin_port = htons((uint16_t)config->port),
+            .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+        };
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr*)&address, sizeof(address)) < 0) {
+            close(fd);
+            fd = -1;
+        }
+        int on = 1;
+        if (fd >= 0) {
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+    }
+    return fd;
+}
+
+static bool sendAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(fd, data, length, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += sent;
+        length -= (size_t)sent;
+    }
+    return true;
+}
+
+// Leitor de linhas sobre o socket.
+typedef struct {
+    int fd;
+    char buffer[4096];
+    size_t length;
+    size_t start;
+} LineReader;
+
+static bool readLine(LineReader* reader, char* line, size_t size) {
+    for (;;) {
+        char* end = memchr(reader->buffer + reader->start, '\n', reader->length - reader->start);
+        if (end) {
+            size_t length = (size_t)(end - (reader->buffer + reader->start));
+            if (length >= size) {
+                length = size - 1;
+            }
+            memcpy(line, reader->buffer + reader->start, length);
+            line[length] = '\0';
+            reader->start = (size_t)(end - reader->buffer) + 1;
+            return true;
+        }
+        memmove(reader->buffer, reader->buffer + reader->start, reader->length - reader->start);
+        reader->length -= reader->start;
+        reader->start = 0;
+        if (reader->length == sizeof(reader->buffer)) {
+            return false;
+        }
+        ssize_t received = recv(reader->fd, reader->buffer + reader->length, sizeof(reader->buffer) - reader->length, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        reader->length += (size_t)received;
+    }
+}
+
+static int clientMain(void* arg) {
+    Client* client = arg;
+    const LoadConfig* config = client->config;
+    // Uma semente por conexão, para a carga ser reproduzível
+    uint64_t rng = config->seed + (uint64_t)client->index * 0x9E3779B97F4A7C15u + 1;
+    LineReader reader = {.fd = connectServer(config)};
+    if (reader.fd < 0) {
+        fprintf(stderr, "Erro ao conectar ao servidor: %s\n", strerror(errno));
+        client->failed = true;
+        return 1;
+    }
+
+    static thread_local char message[LOAD_MAX_BATCH * LOAD_MAX_LINE];
+    for (int done = 0; done < config->requests;) {
+        int count = config->requests - done < config->batch ? config->requests - done : config->batch;
+        size_t length = 0;
+        for (int i = 0; i < count; ++i) {
+            const char* moves;
+            char fresh[LOAD_MAX_LINE];
+            if (config->distinct > 0) {
+                moves = config->pool[nextRandom(&rng) % (uint64_t)config->distinct];
+            } else {
+                randomPosition(&rng, config->plies, fresh);
+                moves = fresh;
+            }
+            length += (size_t)sprintf(message + length, "%s\n", moves);
+        }
+
+        // O lote vai em um único envio; todos os pedidos dele contam a latência a partir desse instante
+        uint64_t sentAt = clockNowUs();
+        if (!sendAll(reader.fd, message, length)) {
+            client->failed = true;
+            break;
+        }
+        for (int i = 0; i < count; ++i) {
+            char line[128];
+            if (!readLine(&reader, line, sizeof(line))) {
+                fprintf(stderr, "Conexão %d encerrada pelo servidor\n", client->index);
+                client->failed = true;
+                close(reader.fd);
+                return 1;
+            }
+            if (strncmp(line, "error", 5) == 0) {
+                client->errors++;
+            }
+            client->latencies[client->answered++] = clockNowUs() - sentAt;
+        }
+        done += count;
+    }
+    close(reader.fd);
+    return 0;
+}
+
+static int compareLatencies(const void* a, const void* b) {
+    uint64_t la = *(const uint64_t*)a;
+    uint64_t lb = *(const uint64_t*)b;
+    return (la > lb) - (la < lb);
+}
+
+static uint64_t percentile(const uint64_t* sorted, size_t count, double fraction) {
+    size_t index = (size_t)(fraction * (double)(count - 1) + 0.5);
+    return sorted[index];
+}
+
+// Função para pedir os contadores do servidor em uma conexão separada.
+static void printServerStats(const LoadConfig* config) {
+    LineReader reader = {.fd = connectServer(config)};
+    char line[128];
+    if (reader.fd >= 0 && sendAll(reader.fd, "stats\n", 6) && readLine(&reader, line, sizeof(line))) {
+        printf("Servidor: %s\n", line);
+    }
+    if (reader.fd >= 0) {
+        close(reader.fd);
+    }
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Uso: %s [opções]\n"
+            "  --unix CAMINHO     conecta a um socket Unix\n"
+            "  --port P           conecta a 127.0.0.1:P (padrão %d, se --unix não for dado)\n"
+            "  --connections C    conexões simultâneas (padrão 8)\n"
+            "  --requests N       pedidos por conexão (padrão 200)\n"
+            "  --batch B          pedidos por envio (padrão 1, máximo %d)\n"
+            "  --plies K          jogadas de cada posição sorteada (padrão 8)\n"
+            "  --distinct D       sorteia entre D posições fixas, para repetir pedidos (padrão 0 = todas novas)\n"
+            "  --seed S           semente do sorteio (padrão 1)\n",
+            program, DEFAULT_PORT, LOAD_MAX_BATCH);
+}
+
+int main(int argc, char* argv[]) {
+    LoadConfig config = {
+        .port = DEFAULT_PORT,
+        .connections = 8,
+        .requests = 200,
+        .batch = 1,
+        .plies = 8,
+        .seed = 1,
+    };
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "--unix") == 0) {
+            config.unixPath = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--port") == 0) {
+            config.port = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--connections") == 0) {
+            config.connections = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--requests") == 0) {
+            config.requests = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--batch") == 0) {
+            config.batch = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--plies") == 0) {
+            config.plies = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--distinct") == 0) {
+            config.distinct = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--seed") == 0) {
+            config.seed = strtoull(argv[++i], nullptr, 10);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (config.connections < 1 || config.requests < 1 || config.batch < 1 || config.batch > LOAD_MAX_BATCH ||
+        config.plies < 0 || config.plies >= ROWS * COLS || config.distinct < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (config.distinct > 0) {
+        config.pool = calloc((size_t)config.distinct, LOAD_MAX_LINE);
+        if (!config.pool) {
+            fprintf(stderr, "Memória insuficiente\n");
+            return 1;
+        }
+        uint64_t rng = config.seed + 1;  // O xorshift não sai do estado 0
+        for (int i = 0; i < config.distinct; ++i) {
+            randomPosition(&rng, config.plies, config.pool[i]);
+        }
+    }
+
+    Client* clients = calloc((size_t)config.connections, sizeof(Client));
+    thrd_t* threads = calloc((size_t)config.connections, sizeof(thrd_t));
+    uint64_t* latencies = calloc((size_t)config.connections * (size_t)config.requests, sizeof(uint64_t));
+    if (!clients || !threads || !latencies) {
+        fprintf(stderr, "Memória insuficiente\n");
+        return 1;
+    }
+
+    uint64_t start = clockNowUs();
+    for (int i = 0; i < config.connections; ++i) {
+        clients[i] = (Client){
+            .config = &config,
+            .index = i,
+            .latencies = latencies + (size_t)i * (size_t)config.requests,
+        };
+        if (thrd_create(&threads[i], clientMain, &clients[i]) != thrd_success) {
+            fprintf(stderr, "Erro ao criar a thread %d\n", i);
+            return 1;
+        }
+    }
+
+    size_t answered = 0;
+    int errors = 0;
+    bool failed = false;
+    for (int i = 0; i < config.connections; ++i) {
+        thrd_join(threads[i], nullptr);
+        // Junta as latências de todas as conexões no início do vetor
+        memmove(latencies + answered, clients[i].latencies, (size_t)clients[i].answered * sizeof(uint64_t));
+        answered += (size_t)clients[i].answered;
+        errors += clients[i].errors;
+        failed |= clients[i].failed;
+    }
+    double seconds = (clockNowUs() - start) / 1e6;
+
+    printf("Pedidos: %zu em %.2f s (%d conexões, lotes de %d), %.0f pedidos/s, %d erros\n", answered, seconds,
+           config.connections, config.batch, seconds > 0 ? answered / seconds : 0.0, errors);
+    if (answered > 0) {
+        qsort(latencies, answered, sizeof(uint64_t), compareLatencies);
+        printf("Latência: p50 %.2f  p95 %.2f  p99 %.2f  máx %.2f ms\n", percentile(latencies, answered, 0.50) / 1000.0,
+               percentile(latencies, answered, 0.95) / 1000.0, percentile(latencies, answered, 0.99) / 1000.0,
+               latencies[answered - 1] / 1000.0);
+    }
+    printServerStats(&config);
+
+    free(config.pool);
+    free(clients);
+    free(threads);
+    free(latencies);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,426 @@
+// Benchmark de desenho sem tela: desenha as telas do jogo em estados fixos (tabuleiro vazio, meio cheio,
+// cheio, peça caindo, telas finais e perguntas) com o renderizador por software da SDL, sob o driver de
+// vídeo "dummy", e mostra por estado os quadros por segundo, o tempo de cada função de desenho e as
+// alocações por quadro. Não precisa de monitor nem de GPU, então roda em contêineres (ver Dockerfile).
+// Com --png, o último quadro de cada estado é gravado para conferência visual.
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "game.h"
+#include "render.h"
+#include "variant.h"
+
+#define DEFAULT_FONT_PATH "fonts/LoveDays-2v7Oe.ttf"
+#define WARMUP_FRAMES 10   // Quadros iniciais fora da medição (rasterização dos textos, texturas)
+#define MAX_STATES 16
+
+typedef enum {
+    FORMAT_TEXT,
+    FORMAT_CSV
+} Format;
+
+// Funções de desenho medidas separadamente.
+typedef enum {
+    STEP_BOARD,            // drawBoard
+    STEP_TURN,             // displayTurn
+    STEP_GAME_OVER,        // drawGameOver
+    STEP_PROMPT,           // drawPrompt
+    STEP_PRESENT,          // SDL_RenderPresent
+    STEP_COUNT
+} Step;
+
+static const char* const stepNames[STEP_COUNT] = {"drawBoard", "displayTurn", "drawGameOver", "drawPrompt",
+                                                  "present"};
+
+typedef struct {
+    const char* name;
+    Scene scene;
+    Game game;
+    uint64_t ticks[STEP_COUNT];  // Tempo acumulado de cada função (SDL_GetPerformanceCounter)
+    uint64_t totalTicks;
+    uint64_t allocations;
+} BenchState;
+
+// Alocações feitas pela SDL e pela SDL_ttf (as da FreeType não passam pelo alocador da SDL).
+static SDL_malloc_func realMalloc;
+static SDL_calloc_func realCalloc;
+static SDL_realloc_func realRealloc;
+static SDL_free_func realFree;
+static uint64_t allocationCount;
+
+static void* countingMalloc(size_t size) {
+    allocationCount++;
+    return realMalloc(size);
+}
+
+static void* countingCalloc(size_t count, size_t size) {
+    allocationCount++;
+    return realCalloc(count, size);
+}
+
+static void* countingRealloc(void* pointer, size_t size) {
+    allocationCount++;
+    return realRealloc(pointer, size);
+}
+
+// Função para preencher o tabuleiro até um número de peças, coluna a coluna em rodízio; as vitórias
+// não são verificadas, só o desenho importa.
+static void fillBoard(Game* game, int stones) {
+    const BoardVariant* variant = game->variant;
+    for (int i = 0; variant->moves(&game->position) < stones; ++i) {
+        dropPiece(game, i % variant->cols);
+    }
+    game->currentPlayer = variant->playerToMove(&game->position);
+}
+
+// Função para montar os estados medidos.
+static int buildStates(BenchState* states, const BoardVariant* variant) {
+    int cells = variant->rows * variant->cols;
+    int count = 0;
+
+    BenchState* state = &states[count++];
+    *state = (BenchState){.name = "titulo"};
+    initGame(&state->game, variant, true);
+    enterScene(&state->scene, SCENE_TITLE);
+
+    state = &states[count++];
+    *state = (BenchState){.name = "vazio"};
+    initGame(&state->game, variant, true);
+    state->game.selectedCol = variant->cols / 2;
+    enterScene(&state->scene, SCENE_PLAYING);
+
+    state = &states[count++];
+    *state = (BenchState){.name = "meio"};
+    initGame(&state->game, variant, true);
+    fillBoard(&state->game, cells / 2);
+    state->game.selectedCol = 0;
+    enterScene(&state->scene, SCENE_PLAYING);
+
+    state = &states[count++];
+    *state = (BenchState){.name = "cheio"};
+    initGame(&state->game, variant, true);
+    fillBoard(&state->game, cells);
+    enterScene(&state->scene, SCENE_PLAYING);
+
+    // Peça no meio da queda, sobre o tabuleiro meio cheio
+    state = &states[count++];
+    *state = (BenchState){.name = "queda"};
+    initGame(&state->game, variant, true);
+    fillBoard(&state->game, cells / 2);
+    state->game.selectedCol = variant->cols / 2;
+    state->game.isDropping = true;
+    state->game.dropRow = variant->landingRow(&state->game.position, state->game.selectedCol);
+    state->game.dropY = 50 + state->game.dropRow * TILE_SIZE / 2;
+    enterScene(&state->scene, SCENE_PLAYING);
+
+    // Telas finais de uma vitória vertical do jogador 1
+    static const GameOverStage stages[] = {GAME_OVER_BOARD, GAME_OVER_HIGHLIGHT, GAME_OVER_MESSAGE};
+    static const char* const stageNames[] = {"fim", "destaque", "resultado"};
+    for (int i = 0; i < 3; ++i) {
+        state = &states[count++];
+        *state = (BenchState){.name = stageNames[i]};
+        initGame(&state->game, variant, true);
+        for (int move = 0; !state->game.gameOver; ++move) {
+            playMove(&state->game, move % 2);
+        }
+        enterScene(&state->scene, SCENE_GAME_OVER);
+        state->scene.stage = stages[i];
+    }
+
+    state = &states[count++];
+    *state = (BenchState){.name = "reinicio"};
+    initGame(&state->game, variant, true);
+    enterScene(&state->scene, SCENE_RESTART);
+    return count;
+}
+
+// Função para desenhar e apresentar um quadro do estado, medindo cada função de desenho.
+static void drawFrame(SDL_Renderer* renderer, RenderCache* cache, TTF_Font* font, BenchState* state, bool measure) {
+    uint64_t ticks[STEP_COUNT] = {0};
+    uint64_t start = SDL_GetPerformanceCounter();
+    uint64_t last = start;
+
+    switch (state->scene.id) {
+        case SCENE_TITLE:
+            drawPrompt(renderer, cache, font, "Escolha o modo de jogo", "1 jogador", "2 jogadores");
+            ticks[STEP_PROMPT] = SDL_GetPerformanceCounter() - last;
+            break;
+        case SCENE_PLAYING:
+            drawBoard(renderer, cache, &state->game);
+            ticks[STEP_BOARD] = SDL_GetPerformanceCounter() - last;
+            last += ticks[STEP_BOARD];
+            displayTurn(renderer, cache, &state->game, font);
+            ticks[STEP_TURN] = SDL_GetPerformanceCounter() - last;
+            break;
+        case SCENE_GAME_OVER:
+            drawGameOver(renderer, cache, &state->scene, &state->game, font);
+            ticks[STEP_GAME_OVER] = SDL_GetPerformanceCounter() - last;
+            break;
+        case SCENE_RESTART:
+            drawPrompt(renderer, cache, font, "Deseja jogar novamente?", "Sim", "Não");
+            ticks[STEP_PROMPT] = SDL_GetPerformanceCounter() - last;
+            break;
+    }
+    last = SDL_GetPerformanceCounter();
+    SDL_RenderPresent(renderer);
+    uint64_t end = SDL_GetPerformanceCounter();
+    ticks[STEP_PRESENT] = end - last;
+
+    if (measure) {
+        for (int i = 0; i < STEP_COUNT; ++i) {
+            state->ticks[i] += ticks[i];
+        }
+        state->totalTicks += end - start;
+    }
+}
+
+// Tabela de CRC-32 (polinômio do PNG e do zlib), montada na primeira chamada.
+static uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t size) {
+    static uint32_t table[256];
+    if (!table[1]) {
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static void putBigEndian32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)(value >> 24);
+    out[1] = (uint8_t)(value >> 16);
+    out[2] = (uint8_t)(value >> 8);
+    out[3] = (uint8_t)value;
+}
+
+static bool writeChunk(FILE* file, const char type[4], const uint8_t* data, size_t size) {
+    uint8_t header[8];
+    putBigEndian32(header, (uint32_t)size);
+    memcpy(header + 4, type, 4);
+    uint8_t trailer[4];
+    putBigEndian32(trailer, crc32Update(crc32Update(0, header + 4, 4), data, size));
+    return fwrite(header, 1, 8, file) == 8 && fwrite(data, 1, size, file) == size && fwrite(trailer, 1, 4, file) == 4;
+}
+
+// Função para gravar uma imagem RGBA em PNG. Os dados vão sem compressão (blocos "stored" do deflate),
+// o que basta para conferir os quadros e dispensa a zlib.
+static bool writePng(const char* path, const uint8_t* rgba, int width, int height) {
+    // Cada linha começa com o byte de filtro (0 = nenhum)
+    size_t rowSize = (size_t)width * 4 + 1;
+    size_t rawSize = rowSize * (size_t)height;
+    size_t blocks = (rawSize + 65534) / 65535;
+    size_t dataSize = 2 + rawSize + blocks * 5 + 4;
+    uint8_t* raw = malloc(rawSize);
+    uint8_t* data = malloc(dataSize);
+    if (!raw || !data) {
+        free(raw);
+        free(data);
+        return false;
+    }
+    for (int y = 0; y < height; ++y) {
+        raw[y * rowSize] = 0;
+        memcpy(raw + y * rowSize + 1, rgba + (size_t)y * width * 4, (size_t)width * 4);
+    }
+
+    // Fluxo zlib: cabeçalho, blocos de até 65535 bytes e Adler-32 dos dados
+    uint8_t* out = data;
+    *out++ = 0x78;
+    *out++ = 0x01;
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (size_t offset = 0; offset < rawSize; offset += 65535) {
+        size_t size = rawSize - offset < 65535 ? rawSize - offset : 65535;
+        *out++ = offset + size == rawSize;  // Último bloco
+        *out++ = (uint8_t)size;
+        *out++ = (uint8_t)(size >> 8);
+        *out++ = (uint8_t)~size;
+        *out++ = (uint8_t)(~size >> 8);
+        memcpy(out, raw + offset, size);
+        out += size;
+        for (size_t i = 0; i < size; ++i) {
+            a = (a + raw[offset + i]) % 65521;
+            b = (b + a) % 65521;
+        }
+    }
+    putBigEndian32(out, b << 16 | a);
+
+    uint8_t header[13];
+    putBigEndian32(header, (uint32_t)width);
+    putBigEndian32(header + 4, (uint32_t)height);
+    header[8] = 8;   // Bits por canal
+    header[9] = 6;   // RGBA
+    header[10] = 0;  // Compressão deflate
+    header[11] = 0;  // Filtros por linha
+    header[12] = 0;  // Sem entrelaçamento
+
+    FILE* file = fopen(path, "wb");
+    bool ok = file != nullptr;
+    if (ok) {
+        static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        ok = fwrite(signature, 1, 8, file) == 8 && writeChunk(file, "IHDR", header, sizeof(header)) &&
+             writeChunk(file, "IDAT", data, dataSize) && writeChunk(file, "IEND", nullptr, 0);
+        ok = fclose(file) == 0 && ok;
+    }
+    free(raw);
+    free(data);
+    return ok;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Uso: %s [opções]\n"
+            "  --frames N       quadros medidos por estado (padrão 500)\n"
+            "  --board CxL      tamanho do tabuleiro (padrão 7x6)\n"
+            "  --font ARQUIVO   fonte dos textos (padrão %s)\n"
+            "  --png DIRETÓRIO  grava o último quadro de cada estado em DIRETÓRIO/estado.png\n"
+            "  --format F       text (padrão) ou csv\n",
+            program, DEFAULT_FONT_PATH);
+}
+
+int main(int argc, char* argv[]) {
+    int frames = 500;
+    const BoardVariant* variant = boardVariants[0];
+    const char* fontPath = DEFAULT_FONT_PATH;
+    const char* pngDir = nullptr;
+    Format format = FORMAT_TEXT;
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "--frames") == 0) {
+            frames = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--board") == 0) {
+            variant = variantFind(argv[++i]);
+            if (!variant) {
+                fprintf(stderr, "Tabuleiro não suportado: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (i + 1 < argc && strcmp(argv[i], "--font") == 0) {
+            fontPath = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--png") == 0) {
+            pngDir = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--format") == 0) {
+            const char* name = argv[++i];
+            if (strcmp(name, "text") == 0) {
+                format = FORMAT_TEXT;
+            } else if (strcmp(name, "csv") == 0) {
+                format = FORMAT_CSV;
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (frames < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // O alocador da SDL é trocado antes de qualquer outra chamada à biblioteca
+    SDL_GetMemoryFunctions(&realMalloc, &realCalloc, &realRealloc, &realFree);
+    SDL_SetMemoryFunctions(countingMalloc, countingCalloc, countingRealloc, realFree);
+
+    // O driver "dummy" dispensa um servidor gráfico; o desenho vai para uma superfície na memória
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_VIDEO) < 0 || TTF_Init() == -1) {
+        fprintf(stderr, "Erro ao inicializar SDL ou SDL_ttf: %s\n", SDL_GetError());
+        return 1;
+    }
+    TTF_Font* font = TTF_OpenFont(fontPath, 24);
+    if (!font) {
+        fprintf(stderr, "Erro ao carregar a fonte %s: %s\n", fontPath, TTF_GetError());
+        return 1;
+    }
+    int width = WINDOW_WIDTH(variant);
+    int height = WINDOW_HEIGHT(variant);
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    RenderCache cache;
+    if (!renderer || !initRenderCache(renderer, &cache, variant)) {
+        fprintf(stderr, "Erro ao criar o renderizador por software: %s\n", SDL_GetError());
+        return 1;
+    }
+    uint8_t* pixels = pngDir ? malloc((size_t)width * height * 4) : nullptr;
+
+    BenchState states[MAX_STATES];
+    int stateCount = buildStates(states, variant);
+    double frequency = (double)SDL_GetPerformanceFrequency();
+
+    if (format == FORMAT_CSV) {
+        printf("state,frames,fps");
+        for (int i = 0; i < STEP_COUNT; ++i) {
+            printf(",%s_us", stepNames[i]);
+        }
+        printf(",allocs_per_frame\n");
+    } else {
+        printf("Tabuleiro %s, %dx%d pixels, %d quadros por estado (tempos em microssegundos por quadro)\n",
+               variant->name, width, height, frames);
+        printf("%-10s %10s", "estado", "quadros/s");
+        for (int i = 0; i < STEP_COUNT; ++i) {
+            printf(" %12s", stepNames[i]);
+        }
+        printf(" %12s\n", "alocações");
+    }
+
+    for (int s = 0; s < stateCount; ++s) {
+        BenchState* state = &states[s];
+        for (int i = 0; i < WARMUP_FRAMES; ++i) {
+            drawFrame(renderer, &cache, font, state, false);
+        }
+        uint64_t allocationsBefore = allocationCount;
+        for (int i = 0; i < frames; ++i) {
+            drawFrame(renderer, &cache, font, state, true);
+        }
+        state->allocations = allocationCount - allocationsBefore;
+
+        double seconds = state->totalTicks / frequency;
+        double fps = seconds > 0 ? frames / seconds : 0.0;
+        double allocationsPerFrame = (double)state->allocations / frames;
+        if (format == FORMAT_CSV) {
+            printf("%s,%d,%.1f", state->name, frames, fps);
+            for (int i = 0; i < STEP_COUNT; ++i) {
+                printf(",%.2f", state->ticks[i] * 1e6 / frequency / frames);
+            }
+            printf(",%.2f\n", allocationsPerFrame);
+        } else {
+            printf("%-10s %10.0f", state->name, fps);
+            for (int i = 0; i < STEP_COUNT; ++i) {
+                if (state->ticks[i]) {
+                    printf(" %12.1f", state->ticks[i] * 1e6 / frequency / frames);
+                } else {
+                    printf(" %12s", "-");
+                }
+            }
+            printf(" %12.2f\n", allocationsPerFrame);
+        }
+
+        if (pngDir) {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/%s.png", pngDir, state->name);
+            if (!pixels || SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_RGBA32, pixels, width * 4) != 0 ||
+                !writePng(path, pixels, width, height)) {
+                fprintf(stderr, "Erro ao gravar %s\n", path);
+                return 1;
+            }
+        }
+    }
+
+    free(pixels);
+    freeRenderCache(&cache);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    TTF_CloseFont(font);
+    TTF_Quit();
+    SDL_Quit();
+    return 0;
+}
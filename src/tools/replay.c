@@ -0,0 +1,290 @@
+// Análise do registro de partidas: percorre o arquivo mapeado na memória, um registro por vez, e mostra
+// estatísticas agregadas por tamanho de tabuleiro (resultados, duração média, taxa de vitória por
+// primeira jogada e aberturas mais frequentes). Também reproduz uma partida específica.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "clock.h"
+#include "gamelog.h"
+#include "position.h"
+
+#define MAX_BOARD_COLS 16
+
+// Totais de uma sequência de jogadas (ou de uma primeira jogada).
+typedef struct {
+    uint64_t games;
+    uint64_t outcomes[4];  // Indexado por GameOutcome
+} OutcomeCounts;
+
+// Estatísticas de um tamanho de tabuleiro.
+typedef struct {
+    int cols;
+    int rows;
+    OutcomeCounts total;
+    uint64_t moveSum;
+    int minMoves;
+    int maxMoves;
+    OutcomeCounts firstMove[MAX_BOARD_COLS];
+} BoardStats;
+
+typedef struct {
+    uint64_t key;          // Tamanho do tabuleiro, número de jogadas e colunas (0 = vazio)
+    OutcomeCounts counts;
+} OpeningEntry;
+
+// Tabela de espalhamento das aberturas: cresce conforme aparecem sequências novas.
+typedef struct {
+    OpeningEntry* slots;
+    size_t capacity;
+    size_t count;
+} OpeningTable;
+
+// Chave de uma abertura: tamanho do tabuleiro nos 8 bits altos, número de jogadas em 4 bits e uma coluna
+// a cada 4 bits (até 12 jogadas).
+static uint64_t openingKey(const GameRecord* record, int plies) {
+    uint64_t key = (uint64_t)(record->cols << 4 | record->rows) << 56 | (uint64_t)plies << 48;
+    for (int i = 0; i < plies; ++i) {
+        key |= (uint64_t)record->moves[i] << (4 * i);
+    }
+    return key;
+}
+
+static OpeningEntry* openingFind(OpeningTable* table, uint64_t key) {
+    if ((table->count + 1) * 2 > table->capacity) {
+        OpeningTable grown = {.capacity = table->capacity ? table->capacity * 2 : 1024};
+        grown.slots = calloc(grown.capacity, sizeof(OpeningEntry));
+        if (!grown.slots) {
+            fprintf(stderr, "Memória insuficiente\n");
+            exit(1);
+        }
+        for (size_t i = 0; i < table->capacity; ++i) {
+            if (table->slots[i].key) {
+                *openingFind(&grown, table->slots[i].key) = table->slots[i];
+            }
+        }
+        free(table->slots);
+        *table = grown;
+    }
+    size_t i = (key * 0x9E3779B97F4A7C15u) >> 20 & (table->capacity - 1);
+    while (table->slots[i].key && table->slots[i].key != key) {
+        i = (i + 1) & (table->capacity - 1);
+    }
+    if (!table->slots[i].key) {
+        table->slots[i].key = key;
+        table->count++;
+    }
+    return &table->slots[i];
+}
+
+static void countOutcome(OutcomeCounts* counts, GameOutcome outcome) {
+    counts->games++;
+    counts->outcomes[outcome]++;
+}
+
+static double percent(uint64_t part, uint64_t total) {
+    return total ? 100.0 * part / total : 0.0;
+}
+
+static int compareOpenings(const void* a, const void* b) {
+    uint64_t ga = ((const OpeningEntry*)a)->counts.games;
+    uint64_t gb = ((const OpeningEntry*)b)->counts.games;
+    return (ga < gb) - (ga > gb);
+}
+
+static const char* outcomeName(GameOutcome outcome) {
+    switch (outcome) {
+        case OUTCOME_PLAYER1: return "vitória do jogador 1";
+        case OUTCOME_PLAYER2: return "vitória do jogador 2";
+        case OUTCOME_ABANDONED: return "interrompida";
+        default: return "empate";
+    }
+}
+
+// Função para mostrar uma partida jogada por jogada (com o tabuleiro quando ele é o padrão).
+static void replayGame(const GameRecord* record, uint64_t index) {
+    printf("Partida %llu: %dx%d, %d jogadas, %s, %s\n", (unsigned long long)index, record->cols, record->rows,
+           record->moveCount, outcomeName(record->outcome), record->vsComputer ? "contra o computador" : "dois jogadores");
+    printf("Jogadas:");
+    for (int i = 0; i < record->moveCount; ++i) {
+        printf(" %d", record->moves[i] + 1);
+    }
+    printf("\n");
+    if (record->cols != COLS || record->rows != ROWS) {
+        return;
+    }
+
+    Position pos;
+    positionInit(&pos);
+    for (int i = 0; i < record->moveCount && positionCanPlay(&pos, record->moves[i]); ++i) {
+        positionPlay(&pos, record->moves[i]);
+        printf("\n%d. coluna %d\n", i + 1, record->moves[i] + 1);
+        for (int row = 0; row < ROWS; ++row) {
+            for (int col = 0; col < COLS; ++col) {
+                Player owner = positionCellOwner(&pos, row, col);
+                putchar(owner == PLAYER1 ? 'X' : owner == PLAYER2 ? 'O' : '.');
+            }
+            putchar('\n');
+        }
+    }
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Uso: %s REGISTRO [opções]\n"
+            "  --openings K  jogadas que definem uma abertura (padrão 4, máximo 12)\n"
+            "  --top N       aberturas mostradas por tabuleiro (padrão 10)\n"
+            "  --game I      reproduz a partida de índice I (a partir de 0) em vez das estatísticas\n",
+            program);
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = nullptr;
+    int plies = 4;
+    int top = 10;
+    long long gameIndex = -1;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "--openings") == 0) {
+            plies = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--top") == 0) {
+            top = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--game") == 0) {
+            gameIndex = atoll(argv[++i]);
+        } else if (argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!path || plies < 1 || plies > 12) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    GameLogReader reader;
+    if (!gameLogReaderOpen(&reader, path)) {
+        fprintf(stderr, "Erro ao abrir o registro %s\n", path);
+        return 1;
+    }
+
+    uint64_t start = clockNowUs();
+    BoardStats* boards[256] = {0};  // Indexado pelo byte de tamanho do registro
+    OpeningTable openings = {0};
+    GameRecord record;
+    uint64_t games = 0;
+    while (gameLogNext(&reader, &record)) {
+        if (gameIndex >= 0) {
+            if (games == (uint64_t)gameIndex) {
+                replayGame(&record, games);
+                gameLogReaderClose(&reader);
+                return 0;
+            }
+            games++;
+            continue;
+        }
+        games++;
+
+        int size = record.cols << 4 | record.rows;
+        BoardStats* board = boards[size];
+        if (!board) {
+            board = boards[size] = calloc(1, sizeof(BoardStats));
+            if (!board) {
+                fprintf(stderr, "Memória insuficiente\n");
+                return 1;
+            }
+            *board = (BoardStats){.cols = record.cols, .rows = record.rows, .minMoves = record.moveCount};
+        }
+        countOutcome(&board->total, record.outcome);
+        board->moveSum += (uint64_t)record.moveCount;
+        if (record.moveCount < board->minMoves) {
+            board->minMoves = record.moveCount;
+        }
+        if (record.moveCount > board->maxMoves) {
+            board->maxMoves = record.moveCount;
+        }
+        if (record.moveCount > 0) {
+            countOutcome(&board->firstMove[record.moves[0]], record.outcome);
+        }
+        if (record.moveCount >= plies) {
+            countOutcome(&openingFind(&openings, openingKey(&record, plies))->counts, record.outcome);
+        }
+    }
+    double seconds = (clockNowUs() - start) / 1e6;
+    if (gameIndex >= 0) {
+        fprintf(stderr, "O registro tem só %llu partidas\n", (unsigned long long)games);
+        gameLogReaderClose(&reader);
+        return 1;
+    }
+    if (reader.offset != reader.size) {
+        fprintf(stderr, "Aviso: registro truncado após %llu partidas\n", (unsigned long long)games);
+    }
+
+    printf("Registro %s: %llu partidas, %.1f MB, lido em %.3f s (%.2f milhões de partidas/s)\n", path,
+           (unsigned long long)games, reader.size / 1e6, seconds, seconds > 0 ? games / seconds / 1e6 : 0.0);
+
+    // As aberturas de todos os tabuleiros ficam juntas, ordenadas pela frequência
+    OpeningEntry* sorted = malloc((openings.count ? openings.count : 1) * sizeof(OpeningEntry));
+    size_t sortedCount = 0;
+    for (size_t i = 0; sorted && i < openings.capacity; ++i) {
+        if (openings.slots[i].key) {
+            sorted[sortedCount++] = openings.slots[i];
+        }
+    }
+    if (sorted) {
+        qsort(sorted, sortedCount, sizeof(OpeningEntry), compareOpenings);
+    }
+
+    for (int size = 0; size < 256; ++size) {
+        const BoardStats* board = boards[size];
+        if (!board) {
+            continue;
+        }
+        const OutcomeCounts* total = &board->total;
+        printf("\nTabuleiro %dx%d: %llu partidas\n", board->cols, board->rows, (unsigned long long)total->games);
+        printf("  Resultados: jogador 1 %.1f%%, jogador 2 %.1f%%, empates %.1f%%, interrompidas %.1f%%\n",
+               percent(total->outcomes[OUTCOME_PLAYER1], total->games),
+               percent(total->outcomes[OUTCOME_PLAYER2], total->games),
+               percent(total->outcomes[OUTCOME_DRAW], total->games),
+               percent(total->outcomes[OUTCOME_ABANDONED], total->games));
+        printf("  Duração: média %.1f jogadas (mínimo %d, máximo %d)\n", (double)board->moveSum / total->games,
+               board->minMoves, board->maxMoves);
+
+        printf("  %-16s %12s %8s %8s %8s\n", "Primeira jogada", "partidas", "J1", "J2", "empate");
+        for (int col = 0; col < board->cols && col < MAX_BOARD_COLS; ++col) {
+            const OutcomeCounts* first = &board->firstMove[col];
+            if (first->games) {
+                printf("  %-16d %12llu %7.1f%% %7.1f%% %7.1f%%\n", col + 1, (unsigned long long)first->games,
+                       percent(first->outcomes[OUTCOME_PLAYER1], first->games),
+                       percent(first->outcomes[OUTCOME_PLAYER2], first->games),
+                       percent(first->outcomes[OUTCOME_DRAW], first->games));
+            }
+        }
+
+        printf("  Aberturas mais frequentes (%d jogadas):\n", plies);
+        int shown = 0;
+        for (size_t i = 0; i < sortedCount && shown < top; ++i) {
+            if ((int)(sorted[i].key >> 56) != size) {
+                continue;
+            }
+            const OutcomeCounts* counts = &sorted[i].counts;
+            char moves[16];
+            for (int p = 0; p < plies; ++p) {
+                int col = (int)(sorted[i].key >> (4 * p) & 0xF);
+                moves[p] = (char)(col < 9 ? '1' + col : 'a' + col - 9);
+            }
+            moves[plies] = '\0';
+            printf("    %-12s %12llu (%5.1f%%)  J1 %5.1f%%  J2 %5.1f%%\n", moves, (unsigned long long)counts->games,
+                   percent(counts->games, total->games), percent(counts->outcomes[OUTCOME_PLAYER1], counts->games),
+                   percent(counts->outcomes[OUTCOME_PLAYER2], counts->games));
+            shown++;
+        }
+    }
+
+    free(sorted);
+    free(openings.slots);
+    for (int size = 0; size < 256; ++size) {
+        free(boards[size]);
+    }
+    gameLogReaderClose(&reader);
+    return 0;
+}
@@ -0,0 +1,726 @@
+// Servidor de jogadas sem interface gráfica: escuta em um socket Unix ou TCP local e responde, para cada
+// posição recebida, a melhor coluna, a pontuação e a profundidade. Um laço de eventos (epoll) cuida de
+// todas as conexões e um grupo de threads faz as buscas, com uma única tabela de transposição e um único
+// livro de aberturas. Pedidos iguais que chegam enquanto a mesma posição ainda está sendo buscada
+// esperam por essa busca em vez de começar outra.
+//
+// Protocolo, uma linha por pedido (vários pedidos podem ir no mesmo envio; as respostas saem na ordem
+// dos pedidos de cada conexão):
+//   "4453"   jogadas desde o início (colunas de 1 a 7; linha vazia = tabuleiro vazio)
+//            -> "COLUNA PONTUAÇÃO PROFUNDIDADE" (coluna de 1 a 7)
+//   "stats"  -> "stats requests=N searches=N coalesced=N errors=N"
+// Posições inválidas, terminadas ou linhas longas demais recebem "error MENSAGEM".
+#define _GNU_SOURCE
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <threads.h>
+#include <unistd.h>
+#include "clock.h"
+#include "search.h"
+
+#define DEFAULT_PORT 4004
+#define SERVER_MAX_EVENTS 64
+#define SERVER_INPUT_SIZE 4096     // Buffer de leitura de cada conexão (uma linha não pode passar disso)
+#define SERVER_RESPONSE_SIZE 80
+#define SERVER_MAX_PENDING 1024    // Pedidos sem resposta enviada por conexão antes de parar de ler o socket
+#define SERVER_MAX_OUTPUT (4 * SERVER_INPUT_SIZE)  // Bytes não enviados por conexão antes de parar de ler
+#define INFLIGHT_BUCKETS 1024      // Tabela das buscas em andamento (potência de 2)
+
+typedef struct Connection Connection;
+
+// Um pedido de uma conexão; fica na lista da conexão até a resposta ser copiada para o buffer de saída.
+typedef struct Request {
+    Connection* connection;
+    struct Request* next;        // Próximo pedido da mesma conexão, na ordem de chegada
+    struct Request* nextWaiter;  // Próximo pedido à espera da mesma busca
+    bool done;
+    char response[SERVER_RESPONSE_SIZE];
+} Request;
+
+struct Connection {
+    int fd;
+    uint32_t events;             // Eventos registrados no epoll
+    bool closed;                 // O cliente saiu; a conexão é liberada quando as buscas pendentes terminarem
+    bool dirty;                  // Há respostas prontas a enviar neste ciclo
+    Connection* nextDirty;
+    char input[SERVER_INPUT_SIZE];
+    size_t inputLength;
+    char* output;
+    size_t outputLength;
+    size_t outputSent;
+    size_t outputCapacity;
+    Request* head;               // Pedidos ainda sem resposta copiada, na ordem de chegada
+    Request* tail;
+    int requests;                // Pedidos na lista
+    int unsent;                  // Respostas no buffer de saída ainda não enviadas por completo
+    int searching;               // Pedidos à espera de uma busca
+};
+
+// Uma busca: criada pelo laço de eventos, executada por uma thread do grupo e devolvida ao laço.
+typedef struct Job {
+    uint64_t key;
+    Position pos;
+    Request* waiters;
+    struct Job* nextInBucket;    // Encadeamento na tabela de buscas em andamento
+    struct Job* next;            // Encadeamento na fila ou na lista de buscas terminadas
+    SearchResult result;
+} Job;
+
+typedef struct {
+    Engine engine;               // Tabela de transposição e livro compartilhados pelas threads
+    SearchLimits limits;
+    int epoll;
+    int listenFd;
+    int wakeFd;                  // eventfd sinalizado pelas threads quando há buscas terminadas
+    bool tcp;
+
+    mtx_t lock;                  // Protege a fila, a lista de terminadas e quit
+    cnd_t wake;
+    Job* queueHead;
+    Job* queueTail;
+    Job* finished;
+    bool quit;
+
+    // Somente o laço de eventos usa os campos abaixo
+    Job* inflight[INFLIGHT_BUCKETS];
+    Connection* dirty;
+    uint64_t requests;
+    uint64_t searches;
+    uint64_t coalesced;
+    uint64_t errors;
+    uint64_t searchUs;
+} Server;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int signal) {
+    (void)signal;
+    stopRequested = 1;
+}
+
+static int workerMain(void* arg) {
+    Server* server = arg;
+    Engine engine;
+    engineShare(&engine, &server->engine);
+
+    for (;;) {
+        mtx_lock(&server->lock);
+        while (!server->queueHead && !server->quit) {
+            cnd_wait(&server->wake, &server->lock);
+        }
+        if (server->quit) {
+            mtx_unlock(&server->lock);
+            return 0;
+        }
+        Job* job = server->queueHead;
+        server->queueHead = job->next;
+        if (!server->queueHead) {
+            server->queueTail = nullptr;
+        }
+        mtx_unlock(&server->lock);
+
+        job->result = searchBestMove(&engine, &job->pos, &server->limits);
+
+        // Só acorda o laço de eventos se a lista estava vazia; as demais buscas vão no mesmo despertar
+        mtx_lock(&server->lock);
+        bool wasEmpty = server->finished == nullptr;
+        job->next = server->finished;
+        server->finished = job;
+        mtx_unlock(&server->lock);
+        if (wasEmpty) {
+            uint64_t one = 1;
+            ssize_t written = write(server->wakeFd, &one, sizeof(one));
+            (void)written;
+        }
+    }
+}
+
+static void* growBuffer(void* data, size_t* capacity, size_t needed) {
+    if (needed <= *capacity) {
+        return data;
+    }
+    size_t grown = *capacity ? *capacity : 1024;
+    while (grown < needed) {
+        grown *= 2;
+    }
+    void* resized = realloc(data, grown);
+    if (!resized) {
+        fprintf(stderr, "Memória insuficiente\n");
+        exit(1);
+    }
+    *capacity = grown;
+    return resized;
+}
+
+// Função para verificar se a conexão pode receber mais pedidos: as respostas ainda não enviadas contam como
+// pendentes, e um cliente que não lê as respostas deixa de ser lido em vez de encher a memória do servidor.
+static bool connectionAcceptsRequests(const Connection* connection) {
+    return connection->requests + connection->unsent < SERVER_MAX_PENDING &&
+           connection->outputLength - connection->outputSent < SERVER_MAX_OUTPUT;
+}
+
+// Função para registrar no epoll só os eventos de que a conexão precisa agora: leitura enquanto houver
+// espaço no buffer e poucos pedidos pendentes, escrita enquanto houver resposta não enviada.
+static void connectionUpdateEvents(Server* server, Connection* connection) {
+    if (connection->closed) {
+        return;
+    }
+    uint32_t events = 0;
+    if (connection->inputLength < SERVER_INPUT_SIZE && connectionAcceptsRequests(connection)) {
+        events |= EPOLLIN;
+    }
+    if (connection->outputSent < connection->outputLength) {
+        events |= EPOLLOUT;
+    }
+    if (events != connection->events) {
+        struct epoll_event event = {.events = events, .data.ptr = connection};
+        epoll_ctl(server->epoll, EPOLL_CTL_MOD, connection->fd, &event);
+        connection->events = events;
+    }
+}
+
+static void markDirty(Server* server, Connection* connection) {
+    if (!connection->dirty) {
+        connection->dirty = true;
+        connection->nextDirty = server->dirty;
+        server->dirty = connection;
+    }
+}
+
+// Função para fechar o socket de uma conexão; a estrutura continua viva enquanto houver buscas com
+// pedidos dela.
+static void connectionClose(Server* server, Connection* connection) {
+    if (!connection->closed) {
+        epoll_ctl(server->epoll, EPOLL_CTL_DEL, connection->fd, nullptr);
+        close(connection->fd);
+        connection->closed = true;
+    }
+    markDirty(server, connection);
+}
+
+static void connectionFree(Connection* connection) {
+    while (connection->head) {
+        Request* request = connection->head;
+        connection->head = request->next;
+        free(request);
+    }
+    free(connection->output);
+    free(connection);
+}
+
+// Função para copiar as respostas prontas (na ordem dos pedidos) para o buffer de saída e enviá-lo.
+// Devolve false se a conexão foi liberada.
+static bool connectionFlush(Server* server, Connection* connection) {
+    while (connection->head && connection->head->done) {
+        Request* request = connection->head;
+        if (!connection->closed) {
+            size_t length = strlen(request->response);
+            connection->output = growBuffer(connection->output, &connection->outputCapacity,
+                                            connection->outputLength + length);
+            memcpy(connection->output + connection->outputLength, request->response, length);
+            connection->outputLength += length;
+            connection->unsent++;
+        }
+        connection->head = request->next;
+        if (!connection->head) {
+            connection->tail = nullptr;
+        }
+        connection->requests--;
+        free(request);
+    }
+
+    if (connection->closed) {
+        if (connection->searching == 0) {
+            connectionFree(connection);
+            return false;
+        }
+        return true;
+    }
+
+    while (connection->outputSent < connection->outputLength) {
+        ssize_t sent = send(connection->fd, connection->output + connection->outputSent,
+                            connection->outputLength - connection->outputSent, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                connectionClose(server, connection);
+            }
+            break;
+        }
+        connection->outputSent += (size_t)sent;
+    }
+    if (connection->outputSent == connection->outputLength) {
+        connection->outputSent = 0;
+        connection->outputLength = 0;
+        connection->unsent = 0;
+    }
+    connectionUpdateEvents(server, connection);
+    return true;
+}
+
+static Job** inflightBucket(Server* server, uint64_t key) {
+    return &server->inflight[(key * 0x9E3779B97F4A7C15u) >> 40 & (INFLIGHT_BUCKETS - 1)];
+}
+
+// Função para acrescentar um pedido ao fim da lista da conexão.
+static Request* addRequest(Server* server, Connection* connection) {
+    Request* request = calloc(1, sizeof(Request));
+    if (!request) {
+        fprintf(stderr, "Memória insuficiente\n");
+        exit(1);
+    }
+    request->connection = connection;
+    if (connection->tail) {
+        connection->tail->next = request;
+    } else {
+        connection->head = request;
+    }
+    connection->tail = request;
+    connection->requests++;
+    server->requests++;
+    return request;
+}
+
+// Função para tratar uma linha de pedido: responde na hora os pedidos inválidos e os de estatística, junta
+// o pedido a uma busca em andamento da mesma posição ou cria uma busca nova (em queued, na ordem inversa).
+static void handleLine(Server* server, Connection* connection, char* line, Job** queued) {
+    Request* request = addRequest(server, connection);
+    size_t length = strlen(line);
+    if (length > 0 && line[length - 1] == '\r') {
+        line[--length] = '\0';
+    }
+
+    Position pos;
+    if (strcmp(line, "stats") == 0) {
+        snprintf(request->response, sizeof(request->response),
+                 "stats requests=%llu searches=%llu coalesced=%llu errors=%llu\n",
+                 (unsigned long long)server->requests, (unsigned long long)server->searches,
+                 (unsigned long long)server->coalesced, (unsigned long long)server->errors);
+    } else if (positionFromMoves(&pos, line) < 0) {
+        snprintf(request->response, sizeof(request->response), "error invalid position\n");
+        server->errors++;
+    } else if (positionIsFull(&pos)) {
+        snprintf(request->response, sizeof(request->response), "error board is full\n");
+        server->errors++;
+    } else {
+        uint64_t key = positionKey(&pos);
+        Job** bucket = inflightBucket(server, key);
+        Job* job = *bucket;
+        while (job && job->key != key) {
+            job = job->nextInBucket;
+        }
+        if (job) {
+            server->coalesced++;
+        } else {
+            job = calloc(1, sizeof(Job));
+            if (!job) {
+                fprintf(stderr, "Memória insuficiente\n");
+                exit(1);
+            }
+            job->key = key;
+            job->pos = pos;
+            job->nextInBucket = *bucket;
+            *bucket = job;
+            job->next = *queued;
+            *queued = job;
+            server->searches++;
+        }
+        request->nextWaiter = job->waiters;
+        job->waiters = request;
+        connection->searching++;
+        return;
+    }
+    request->done = true;
+    markDirty(server, connection);
+}
+
+// Função para tratar as linhas completas do buffer de leitura. As linhas ficam no buffer enquanto a
+// conexão tiver pedidos demais sem resposta enviada.
+static void connectionParse(Server* server, Connection* connection, Job** queued) {
+    size_t consumed = 0;
+    while (connectionAcceptsRequests(connection)) {
+        char* end = memchr(connection->input + consumed, '\n', connection->inputLength - consumed);
+        if (!end) {
+            break;
+        }
+        *end = '\0';
+        handleLine(server, connection, connection->input + consumed, queued);
+        consumed = (size_t)(end - connection->input) + 1;
+    }
+    memmove(connection->input, connection->input + consumed, connection->inputLength - consumed);
+    connection->inputLength -= consumed;
+
+    if (connection->inputLength == SERVER_INPUT_SIZE && !memchr(connection->input, '\n', SERVER_INPUT_SIZE)) {
+        // Uma linha maior que o buffer não é um pedido válido: responde o erro e encerra a conexão
+        Request* request = addRequest(server, connection);
+        snprintf(request->response, sizeof(request->response), "error line too long\n");
+        request->done = true;
+        server->errors++;
+        connection->inputLength = 0;
+        if (connectionFlush(server, connection)) {
+            connectionClose(server, connection);
+        }
+        return;
+    }
+    connectionUpdateEvents(server, connection);
+}
+
+// Função para ler o que chegou em uma conexão e tratar as linhas completas.
+static void connectionRead(Server* server, Connection* connection, Job** queued) {
+    ssize_t received = recv(connection->fd, connection->input + connection->inputLength,
+                            SERVER_INPUT_SIZE - connection->inputLength, 0);
+    if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        connectionClose(server, connection);
+        return;
+    }
+    if (received > 0) {
+        connection->inputLength += (size_t)received;
+    }
+    connectionParse(server, connection, queued);
+}
+
+// Função para colocar na fila das threads as buscas criadas (recebidas em ordem inversa), com um único
+// despertar.
+static void enqueueJobs(Server* server, Job* queued) {
+    if (!queued) {
+        return;
+    }
+    Job* ordered = nullptr;
+    Job* last = queued;
+    while (queued) {
+        Job* next = queued->next;
+        queued->next = ordered;
+        ordered = queued;
+        queued = next;
+    }
+    mtx_lock(&server->lock);
+    if (server->queueTail) {
+        server->queueTail->next = ordered;
+    } else {
+        server->queueHead = ordered;
+    }
+    server->queueTail = last;
+    cnd_broadcast(&server->wake);
+    mtx_unlock(&server->lock);
+}
+
+static void acceptConnections(Server* server) {
+    for (;;) {
+        int fd = accept(server->listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                fprintf(stderr, "Erro ao aceitar conexão: %s\n", strerror(errno));
+            }
+            return;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        if (server->tcp) {
+            int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+        Connection* connection = calloc(1, sizeof(Connection));
+        if (!connection) {
+            close(fd);
+            continue;
+        }
+        connection->fd = fd;
+        connection->events = EPOLLIN;
+        struct epoll_event event = {.events = EPOLLIN, .data.ptr = connection};
+        if (epoll_ctl(server->epoll, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            free(connection);
+        }
+    }
+}
+
+// Função para entregar as buscas terminadas aos pedidos que esperavam por elas.
+static void deliverResults(Server* server) {
+    uint64_t count;
+    ssize_t received = read(server->wakeFd, &count, sizeof(count));
+    (void)received;
+
+    mtx_lock(&server->lock);
+    Job* job = server->finished;
+    server->finished = nullptr;
+    mtx_unlock(&server->lock);
+
+    while (job) {
+        Job* next = job->next;
+        Job** link = inflightBucket(server, job->key);
+        while (*link != job) {
+            link = &(*link)->nextInBucket;
+        }
+        *link = job->nextInBucket;
+
+        server->searchUs += job->result.elapsedUs;
+        for (Request* request = job->waiters; request; request = request->nextWaiter) {
+            snprintf(request->response, sizeof(request->response), "%d %d %d\n", job->result.bestCol + 1,
+                     job->result.score, job->result.depth);
+            request->done = true;
+            request->connection->searching--;
+            markDirty(server, request->connection);
+        }
+        free(job);
+        job = next;
+    }
+}
+
+static int openListener(Server* server, const char* unixPath, int port) {
+    int fd;
+    if (unixPath) {
+        struct sockaddr_un address = {.sun_family = AF_UNIX};
+        if (strlen(unixPath) >= sizeof(address.sun_path)) {
+            fprintf(stderr, "Caminho do socket longo demais: %s\n", unixPath);
+            return -1;
+        }
+        strcpy(address.sun_path, unixPath);
+        // Um socket deixado por um servidor que não terminou direito faria o bind falhar; outros tipos de
+        // arquivo no caminho não são apagados
+        struct stat status;
+        if (lstat(unixPath, &status) == 0 && S_ISSOCK(status.st_mode)) {
+            unlink(unixPath);
+        }
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || bind(fd, (struct sockaddr*)&address, sizeof(address)) < 0) {
+            fprintf(stderr, "Erro ao abrir o socket %s: %s\n", unixPath, strerror(errno));
+            return -1;
+        }
+    } else {
+        struct sockaddr_in address = {
+            .sin_family = AF_INET,
+            .sin_port = htons((uint16_t)port),
+            .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+        };
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        int on = 1;
+        if (fd >= 0) {
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        }
+        if (fd < 0 || bind(fd, (struct sockaddr*)&address, sizeof(address)) < 0) {
+            fprintf(stderr, "Erro ao abrir a porta %d: %s\n", port, strerror(errno));
+            return -1;
+        }
+        server->tcp = true;
+    }
+    if (listen(fd, SOMAXCONN) < 0) {
+        fprintf(stderr, "Erro ao escutar: %s\n", strerror(errno));
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Uso: %s [opções]\n"
+            "  --unix CAMINHO  escuta em um socket Unix\n"
+            "  --port P        escuta em 127.0.0.1:P (padrão %d, se --unix não for dado)\n"
+            "  --workers W     buscas simultâneas (padrão 4)\n"
+            "  --threads T     threads por busca (padrão 1)\n"
+            "  --time MS       tempo por busca (padrão 50)\n"
+            "  --depth D       profundidade máxima (padrão 0 = sem limite)\n"
+            "  --hash MB       tabela de transposição compartilhada (padrão 128)\n"
+            "  --book ARQUIVO  livro de aberturas (opcional)\n"
+            "  --endgame ARQUIVO  banco de finais (opcional)\n",
+            program, DEFAULT_PORT);
+}
+
+int main(int argc, char* argv[]) {
+    const char* unixPath = nullptr;
+    const char* bookPath = nullptr;
+    const char* endgamePath = nullptr;
+    int port = DEFAULT_PORT;
+    int workers = 4;
+    size_t hashMegabytes = 128;
+    SearchLimits limits = {.timeLimitMs = 50, .threads = 1};
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "--unix") == 0) {
+            unixPath = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--port") == 0) {
+            port = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--workers") == 0) {
+            workers = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--threads") == 0) {
+            limits.threads = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--time") == 0) {
+            limits.timeLimitMs = (uint32_t)atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--depth") == 0) {
+            limits.maxDepth = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--hash") == 0) {
+            hashMegabytes = (size_t)atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--book") == 0) {
+            bookPath = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--endgame") == 0) {
+            endgamePath = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (workers < 1) {
+        workers = 1;
+    }
+    if (limits.timeLimitMs == 0 && limits.maxDepth == 0) {
+        fprintf(stderr, "Defina --time ou --depth: buscas sem limite podem levar horas\n");
+        return 1;
+    }
+
+    static Server server;
+    if (!engineInit(&server.engine, hashMegabytes)) {
+        fprintf(stderr, "Erro ao alocar a tabela de transposição (%zu MB)\n", hashMegabytes);
+        return 1;
+    }
+    OpeningBook book;
+    if (bookPath) {
+        if (!bookOpen(&book, bookPath)) {
+            fprintf(stderr, "Erro ao abrir o livro de aberturas %s\n", bookPath);
+            return 1;
+        }
+        server.engine.book = &book;
+    }
+    EndgameTable endgame;
+    if (endgamePath) {
+        if (!endgameOpen(&endgame, endgamePath)) {
+            fprintf(stderr, "Erro ao abrir o banco de finais %s\n", endgamePath);
+            return 1;
+        }
+        server.engine.endgame = &endgame;
+    }
+    server.limits = limits;
+    mtx_init(&server.lock, mtx_plain);
+    cnd_init(&server.wake);
+
+    server.listenFd = openListener(&server, unixPath, port);
+    server.epoll = epoll_create1(0);
+    server.wakeFd = eventfd(0, EFD_NONBLOCK);
+    if (server.listenFd < 0 || server.epoll < 0 || server.wakeFd < 0) {
+        return 1;
+    }
+    struct epoll_event event = {.events = EPOLLIN, .data.ptr = &server.listenFd};
+    epoll_ctl(server.epoll, EPOLL_CTL_ADD, server.listenFd, &event);
+    event = (struct epoll_event){.events = EPOLLIN, .data.ptr = &server.wakeFd};
+    epoll_ctl(server.epoll, EPOLL_CTL_ADD, server.wakeFd, &event);
+
+    thrd_t* threads = calloc((size_t)workers, sizeof(thrd_t));
+    if (!threads) {
+        fprintf(stderr, "Memória insuficiente\n");
+        return 1;
+    }
+    for (int i = 0; i < workers; ++i) {
+        if (thrd_create(&threads[i], workerMain, &server) != thrd_success) {
+            fprintf(stderr, "Erro ao criar a thread %d\n", i);
+            return 1;
+        }
+    }
+
+    // Sem SA_RESTART, o sinal interrompe o epoll_wait e o laço termina
+    struct sigaction action = {.sa_handler = onSignal};
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    if (unixPath) {
+        printf("Servidor escutando em %s (%d buscas simultâneas, %u ms por busca)\n", unixPath, workers,
+               limits.timeLimitMs);
+    } else {
+        printf("Servidor escutando em 127.0.0.1:%d (%d buscas simultâneas, %u ms por busca)\n", port, workers,
+               limits.timeLimitMs);
+    }
+    fflush(stdout);
+
+    uint64_t start = clockNowUs();
+    struct epoll_event events[SERVER_MAX_EVENTS];
+    while (!stopRequested) {
+        int count = epoll_wait(server.epoll, events, SERVER_MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fprintf(stderr, "Erro no epoll_wait: %s\n", strerror(errno));
+            break;
+        }
+
+        // As buscas criadas neste ciclo entram na fila de uma vez, com um único despertar das threads
+        Job* queued = nullptr;
+        for (int i = 0; i < count; ++i) {
+            void* source = events[i].data.ptr;
+            if (source == &server.listenFd) {
+                acceptConnections(&server);
+            } else if (source == &server.wakeFd) {
+                deliverResults(&server);
+            } else {
+                Connection* connection = source;
+                if (connection->closed) {
+                    continue;
+                }
+                if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                    connectionClose(&server, connection);
+                    continue;
+                }
+                if (events[i].events & EPOLLIN) {
+                    connectionRead(&server, connection, &queued);
+                }
+                if (!connection->closed && (events[i].events & EPOLLOUT)) {
+                    markDirty(&server, connection);
+                }
+            }
+        }
+
+        // Cada conexão com respostas prontas recebe todas elas em um único envio; as linhas que
+        // ficaram no buffer por excesso de pedidos pendentes são tratadas agora
+        while (server.dirty) {
+            Connection* connection = server.dirty;
+            server.dirty = connection->nextDirty;
+            connection->dirty = false;
+            if (connectionFlush(&server, connection) && !connection->closed && connection->inputLength > 0) {
+                connectionParse(&server, connection, &queued);
+            }
+        }
+        enqueueJobs(&server, queued);
+    }
+    double seconds = (clockNowUs() - start) / 1e6;
+
+    mtx_lock(&server.lock);
+    server.quit = true;
+    cnd_broadcast(&server.wake);
+    mtx_unlock(&server.lock);
+    for (int i = 0; i < workers; ++i) {
+        thrd_join(threads[i], nullptr);
+    }
+
+    printf("\nPedidos: %llu em %.1f s, buscas: %llu (%.2f ms em média), agrupados: %llu, erros: %llu\n",
+           (unsigned long long)server.requests, seconds, (unsigned long long)server.searches,
+           server.searches ? server.searchUs / 1000.0 / server.searches : 0.0,
+           (unsigned long long)server.coalesced, (unsigned long long)server.errors);
+
+    close(server.listenFd);
+    close(server.wakeFd);
+    close(server.epoll);
+    if (unixPath) {
+        unlink(unixPath);
+    }
+    free(threads);
+    engineFree(&server.engine);
+    if (bookPath) {
+        bookClose(&book);
+    }
+    if (endgamePath) {
+        endgameClose(&endgame);
+    }
+    return 0;
+}
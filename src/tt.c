@@ -0,0 +1,62 @@
+#include "tt.h"
+#include <stdlib.h>
+
+// Função para verificar se um número é primo (usada só na alocação da tabela).
+static bool isPrime(size_t n) {
+    if (n < 2) {
+        return false;
+    }
+    for (size_t d = 2; d * d <= n; ++d) {
+        if (n % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ttInit(TranspositionTable* tt, size_t megabytes) {
+    *tt = (TranspositionTable){0};
+    size_t size = megabytes * 1024 * 1024 / sizeof(uint64_t);
+    while (size > 0 && !isPrime(size)) {
+        size--;
+    }
+    if (size == 0) {
+        return megabytes == 0;
+    }
+    tt->entries = calloc(size, sizeof(*tt->entries));
+    if (!tt->entries) {
+        return false;
+    }
+    tt->size = size;
+    // 2^log2(size) <= size: chaves menores que 2^(log2(size) + 32) cabem no intervalo identificado
+    tt->exactKeyBits = TT_KEY_BITS;
+    for (size_t power = size; power > 1; power >>= 1) {
+        tt->exactKeyBits++;
+    }
+    return true;
+}
+
+void ttFree(TranspositionTable* tt) {
+    free(tt->entries);
+    *tt = (TranspositionTable){0};
+}
+
+void ttClear(TranspositionTable* tt) {
+    for (size_t i = 0; i < tt->size; ++i) {
+        atomic_store_explicit(&tt->entries[i], 0, memory_order_relaxed);
+    }
+    tt->generation = 0;
+}
+
+void ttNewSearch(TranspositionTable* tt) {
+    tt->generation = (tt->generation + 1) & TT_GENERATION_MASK;
+}
+
+void ttStatsAdd(TTStats* total, const TTStats* stats) {
+    total->probes += stats->probes;
+    total->hits += stats->hits;
+    total->misses += stats->misses;
+    total->collisions += stats->collisions;
+    total->stores += stats->stores;
+    total->overwrites += stats->overwrites;
+}
@@ -0,0 +1,133 @@
+#ifndef TT_H
+#define TT_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Tabela de transposição de tamanho fixo. Cada entrada ocupa 8 bytes:
+//   bits  0-31  chave parcial (32 bits baixos da chave da posição)
+//   bits 32-47  pontuação (int16)
+//   bits 48-54  profundidade restante
+//   bits 55-56  tipo de limite (Bound)
+//   bits 57-60  melhor coluna + 1 (0 = nenhuma)
+//   bits 61-63  geração da busca que gravou a entrada
+// O índice é a chave módulo um número primo de entradas; como o primo é ímpar, índice e chave parcial
+// juntos determinam a chave módulo primo * 2^32. A posição fica identificada sem ambiguidade só se a chave
+// tiver no máximo exactKeyBits bits: é o caso do tabuleiro 7x6 (chave de 49 bits) a partir de tabelas de 2 MB.
+// Nos tabuleiros maiores uma entrada de outra posição pode passar pela verificação (ver a busca).
+// Cada entrada é lida e gravada como uma única palavra atômica, então várias threads compartilham a
+// tabela sem travas: uma entrada nunca é vista pela metade e a chave parcial descarta as de outra posição.
+
+typedef enum {
+    BOUND_NONE = 0,   // Entrada vazia
+    BOUND_EXACT,
+    BOUND_LOWER,      // A pontuação real é maior ou igual
+    BOUND_UPPER       // A pontuação real é menor ou igual
+} Bound;
+
+typedef struct {
+    int score;
+    int depth;
+    Bound bound;
+    int move;         // -1 se não houver
+} TTEntry;
+
+// Contadores de uso; cada busca mantém os seus e a tabela em si não é alterada por eles.
+typedef struct {
+    uint64_t probes;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t collisions;   // Consultas que encontraram outra posição no mesmo índice
+    uint64_t stores;
+    uint64_t overwrites;   // Gravações que substituíram outra posição
+} TTStats;
+
+typedef struct {
+    _Atomic uint64_t* entries;
+    size_t size;           // Número de entradas (0 = tabela desativada)
+    int exactKeyBits;      // Chaves com até esse número de bits são identificadas sem ambiguidade
+    uint8_t generation;
+} TranspositionTable;
+
+// Função para alocar a tabela com no máximo o número de megabytes pedido (0 desativa a tabela).
+bool ttInit(TranspositionTable* tt, size_t megabytes);
+void ttFree(TranspositionTable* tt);
+void ttClear(TranspositionTable* tt);
+// Função para marcar o início de uma nova busca; entradas de buscas anteriores passam a ser substituíveis.
+void ttNewSearch(TranspositionTable* tt);
+void ttStatsAdd(TTStats* total, const TTStats* stats);
+
+#define TT_KEY_BITS 32
+#define TT_SCORE_SHIFT 32
+#define TT_DEPTH_SHIFT 48
+#define TT_BOUND_SHIFT 55
+#define TT_MOVE_SHIFT 57
+#define TT_GENERATION_SHIFT 61
+#define TT_GENERATION_MASK 7u
+
+static inline uint64_t ttPack(uint64_t key, int depth, Bound bound, int score, int move, unsigned generation) {
+    return (key & 0xFFFFFFFFu) |
+           (uint64_t)(uint16_t)(int16_t)score << TT_SCORE_SHIFT |
+           (uint64_t)(depth & 0x7F) << TT_DEPTH_SHIFT |
+           (uint64_t)bound << TT_BOUND_SHIFT |
+           (uint64_t)(move + 1) << TT_MOVE_SHIFT |
+           (uint64_t)(generation & TT_GENERATION_MASK) << TT_GENERATION_SHIFT;
+}
+
+static inline Bound ttEntryBound(uint64_t data) {
+    return (Bound)(data >> TT_BOUND_SHIFT & 3);
+}
+
+static inline int ttEntryDepth(uint64_t data) {
+    return (int)(data >> TT_DEPTH_SHIFT & 0x7F);
+}
+
+static inline unsigned ttEntryGeneration(uint64_t data) {
+    return (unsigned)(data >> TT_GENERATION_SHIFT) & TT_GENERATION_MASK;
+}
+
+// Função para consultar a posição; devolve true e preenche a entrada em caso de acerto.
+static inline bool ttProbe(const TranspositionTable* tt, uint64_t key, TTEntry* entry, TTStats* stats) {
+    if (tt->size == 0) {
+        return false;
+    }
+    stats->probes++;
+    uint64_t data = atomic_load_explicit(&tt->entries[key % tt->size], memory_order_relaxed);
+    if (ttEntryBound(data) == BOUND_NONE) {
+        stats->misses++;
+        return false;
+    }
+    if ((uint32_t)data != (uint32_t)key) {
+        stats->misses++;
+        stats->collisions++;
+        return false;
+    }
+    stats->hits++;
+    entry->score = (int16_t)(uint16_t)(data >> TT_SCORE_SHIFT);
+    entry->depth = ttEntryDepth(data);
+    entry->bound = ttEntryBound(data);
+    entry->move = (int)(data >> TT_MOVE_SHIFT & 0xF) - 1;
+    return true;
+}
+
+// Função para gravar um resultado. Política de substituição: a entrada existente só é mantida se for
+// de outra posição, da busca atual e mais profunda que o novo resultado.
+static inline void ttStore(TranspositionTable* tt, uint64_t key, int depth, Bound bound, int score, int move,
+                           TTStats* stats) {
+    if (tt->size == 0) {
+        return;
+    }
+    _Atomic uint64_t* slot = &tt->entries[key % tt->size];
+    uint64_t old = atomic_load_explicit(slot, memory_order_relaxed);
+    if (ttEntryBound(old) != BOUND_NONE && (uint32_t)old != (uint32_t)key) {
+        if (ttEntryGeneration(old) == tt->generation && ttEntryDepth(old) > depth) {
+            return;
+        }
+        stats->overwrites++;
+    }
+    stats->stores++;
+    atomic_store_explicit(slot, ttPack(key, depth, bound, score, move, tt->generation), memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,135 @@
+#include "variant.h"
+#include <string.h>
+#include "gamelog.h"
+
+// Instância da interface de variantes para o tamanho com que este arquivo é compilado.
+
+static_assert(sizeof(Position) <= sizeof(BoardState), "BoardState não comporta a posição desta variante");
+static_assert(ROWS <= VARIANT_MAX_ROWS && COLS <= VARIANT_MAX_COLS, "variante maior que o máximo suportado");
+static_assert(COLS < 15, "a tabela de transposição e o livro guardam a coluna em 4 bits");
+static_assert(ROWS * COLS <= GAMELOG_MAX_MOVES, "o registro de partidas não comporta uma partida completa");
+
+#define VARIANT_STRING_(variant) #variant
+#define VARIANT_STRING(variant) VARIANT_STRING_(variant)
+
+static Position load(const BoardState* state) {
+    Position pos;
+    memcpy(&pos, state->bytes, sizeof(pos));
+    return pos;
+}
+
+static void store(BoardState* state, const Position* pos) {
+    memcpy(state->bytes, pos, sizeof(*pos));
+}
+
+static void variantInit(BoardState* state) {
+    Position pos;
+    positionInit(&pos);
+    store(state, &pos);
+}
+
+static bool variantCanPlay(const BoardState* state, int col) {
+    Position pos = load(state);
+    return positionCanPlay(&pos, col);
+}
+
+static int variantLandingRow(const BoardState* state, int col) {
+    Position pos = load(state);
+    return positionLandingRow(&pos, col);
+}
+
+static void variantPlay(BoardState* state, int col) {
+    Position pos = load(state);
+    positionPlay(&pos, col);
+    store(state, &pos);
+}
+
+static int variantMoves(const BoardState* state) {
+    Position pos = load(state);
+    return pos.moves;
+}
+
+static bool variantIsFull(const BoardState* state) {
+    Position pos = load(state);
+    return positionIsFull(&pos);
+}
+
+static Player variantPlayerToMove(const BoardState* state) {
+    Position pos = load(state);
+    return positionPlayerToMove(&pos);
+}
+
+static Player variantCellOwner(const BoardState* state, int row, int col) {
+    Position pos = load(state);
+    return positionCellOwner(&pos, row, col);
+}
+
+static bool variantWinsWith(const BoardState* state, int col) {
+    Position pos = load(state);
+    return positionWinsWith(&pos, col, positionPlayerToMove(&pos));
+}
+
+static bool variantLastMoveWon(const BoardState* state) {
+    Position pos = load(state);
+    return positionLastMoveWon(&pos);
+}
+
+static bool variantFindFour(const BoardState* state, Player player, int cols[4], int rows[4]) {
+    Position pos = load(state);
+    return bitboardFindFour(positionStones(&pos, player), cols, rows);
+}
+
+static uint64_t variantKey(const BoardState* state) {
+    Position pos = load(state);
+    return positionKey(&pos);
+}
+
+static bool variantSamePosition(const BoardState* a, const BoardState* b) {
+    Position first = load(a);
+    Position second = load(b);
+    return first.current == second.current && first.mask == second.mask;
+}
+
+static SearchResult variantSearchBestMove(Engine* engine, const BoardState* state, const SearchLimits* limits) {
+    Position pos = load(state);
+    return searchBestMove(engine, &pos, limits);
+}
+
+static SearchResult variantMctsBestMove(Mcts* tree, const BoardState* state, const SearchLimits* limits) {
+    Position pos = load(state);
+    return mctsBestMove(tree, &pos, limits);
+}
+
+static int variantHeuristicMove(const BoardState* state) {
+    Position pos = load(state);
+    return searchHeuristicMove(&pos);
+}
+
+const BoardVariant boardVariant = {
+    .name = VARIANT_STRING(BOARD_VARIANT),
+    .rows = ROWS,
+    .cols = COLS,
+    .bitboardBits = (int)sizeof(Bitboard) * 8,
+    .init = variantInit,
+    .canPlay = variantCanPlay,
+    .landingRow = variantLandingRow,
+    .play = variantPlay,
+    .moves = variantMoves,
+    .isFull = variantIsFull,
+    .playerToMove = variantPlayerToMove,
+    .cellOwner = variantCellOwner,
+    .winsWith = variantWinsWith,
+    .lastMoveWon = variantLastMoveWon,
+    .findFour = variantFindFour,
+    .key = variantKey,
+    .samePosition = variantSamePosition,
+    .openBook = bookOpen,
+    .closeBook = bookClose,
+    .openEndgame = endgameOpen,
+    .closeEndgame = endgameClose,
+    .searchBestMove = variantSearchBestMove,
+    .initMcts = mctsInit,
+    .freeMcts = mctsFree,
+    .mctsBestMove = variantMctsBestMove,
+    .heuristicMove = variantHeuristicMove,
+};
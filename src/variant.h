@@ -0,0 +1,60 @@
+#ifndef VARIANT_H
+#define VARIANT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "book.h"
+#include "endgame.h"
+#include "mcts.h"
+#include "search.h"
+
+// Maior tabuleiro suportado entre as variantes compiladas.
+#define VARIANT_MAX_ROWS 8
+#define VARIANT_MAX_COLS 10
+
+// Posição de qualquer variante, guardada sem tipo: só as funções da própria variante a interpretam.
+typedef struct {
+    unsigned char bytes[48];
+} BoardState;
+
+// Interface de uma variante de tabuleiro escolhida em tempo de execução. Cada variante é a mesma lógica e
+// a mesma IA compiladas para um tamanho fixo (ver boardsize.h), com bitboards de 64 ou 128 bits e
+// verificação de vitória sem laços nem desvios; só a chamada através desta tabela é indireta.
+// As linhas são contadas a partir do topo e o "jogador da vez" é o de playerToMove.
+typedef struct {
+    const char* name;      // "colunas x linhas", por exemplo "9x7"
+    int rows;
+    int cols;
+    int bitboardBits;      // 64 ou 128
+    void (*init)(BoardState* state);
+    bool (*canPlay)(const BoardState* state, int col);
+    int (*landingRow)(const BoardState* state, int col);
+    void (*play)(BoardState* state, int col);
+    int (*moves)(const BoardState* state);
+    bool (*isFull)(const BoardState* state);
+    Player (*playerToMove)(const BoardState* state);
+    Player (*cellOwner)(const BoardState* state, int row, int col);
+    bool (*winsWith)(const BoardState* state, int col);   // O jogador da vez venceria jogando na coluna
+    bool (*lastMoveWon)(const BoardState* state);
+    bool (*findFour)(const BoardState* state, Player player, int cols[4], int rows[4]);
+    uint64_t (*key)(const BoardState* state);
+    bool (*samePosition)(const BoardState* a, const BoardState* b);
+    bool (*openBook)(OpeningBook* book, const char* path);
+    void (*closeBook)(OpeningBook* book);
+    bool (*openEndgame)(EndgameTable* table, const char* path);
+    void (*closeEndgame)(EndgameTable* table);
+    SearchResult (*searchBestMove)(Engine* engine, const BoardState* state, const SearchLimits* limits);
+    bool (*initMcts)(Mcts* tree, size_t megabytes);
+    void (*freeMcts)(Mcts* tree);
+    SearchResult (*mctsBestMove)(Mcts* tree, const BoardState* state, const SearchLimits* limits);
+    int (*heuristicMove)(const BoardState* state);
+} BoardVariant;
+
+// Variantes compiladas, na ordem em que são oferecidas; a primeira é o tabuleiro padrão.
+extern const BoardVariant* const boardVariants[];
+extern const size_t boardVariantCount;
+
+// Função para procurar uma variante pelo nome; devolve nullptr se ela não for suportada.
+const BoardVariant* variantFind(const char* name);
+
+#endif
@@ -0,0 +1,26 @@
+#include "variant.h"
+#include <string.h>
+
+// Instâncias geradas por variant.c, uma por tamanho compilado (a lista acompanha C4_BOARD_VARIANTS no
+// CMakeLists.txt).
+extern const BoardVariant boardVariant_7x6;
+extern const BoardVariant boardVariant_8x7;
+extern const BoardVariant boardVariant_9x7;
+extern const BoardVariant boardVariant_10x8;
+
+const BoardVariant* const boardVariants[] = {
+    &boardVariant_7x6,
+    &boardVariant_8x7,
+    &boardVariant_9x7,
+    &boardVariant_10x8,
+};
+const size_t boardVariantCount = sizeof(boardVariants) / sizeof(boardVariants[0]);
+
+const BoardVariant* variantFind(const char* name) {
+    for (size_t i = 0; i < boardVariantCount; ++i) {
+        if (strcmp(boardVariants[i]->name, name) == 0) {
+            return boardVariants[i];
+        }
+    }
+    return nullptr;
+}